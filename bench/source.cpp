@@ -0,0 +1,503 @@
+#include <malloc.h>
+#include <signal.h>
+#include <sys/eventfd.h>
+#include <sys/wait.h>
+#include <systemd/sd-event.h>
+#include <unistd.h>
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/internal/sdevent.hpp>
+#include <sdeventplus/profile.hpp>
+#include <sdeventplus/source/base.hpp>
+#include <sdeventplus/source/child.hpp>
+#include <sdeventplus/source/event.hpp>
+#include <sdeventplus/source/io.hpp>
+#include <sdeventplus/source/signal.hpp>
+#include <sdeventplus/source/time.hpp>
+#include <stdplus/signal.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace sdeventplus
+{
+namespace source
+{
+namespace
+{
+
+/** @brief Creates an eventfd that is released with the benchmark */
+class EventFd
+{
+  public:
+    EventFd() : fd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    {
+        if (fd < 0)
+        {
+            std::abort();
+        }
+    }
+    ~EventFd()
+    {
+        close(fd);
+    }
+    EventFd(const EventFd&) = delete;
+    EventFd& operator=(const EventFd&) = delete;
+
+    const int fd;
+};
+
+void BM_IOConstruct(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    EventFd efd;
+    for (auto _ : state)
+    {
+        IO io(event, efd.fd, EPOLLIN, [](IO&, int, uint32_t) {});
+        benchmark::DoNotOptimize(io.get());
+    }
+}
+BENCHMARK(BM_IOConstruct);
+
+template <ClockId Id>
+void BM_TimeConstruct(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    auto time = Clock<Id>(event).now() + std::chrono::hours{1};
+    for (auto _ : state)
+    {
+        Time<Id> source(event, time, std::chrono::milliseconds{1},
+                        [](Time<Id>&, typename Time<Id>::TimePoint) {});
+        benchmark::DoNotOptimize(source.get());
+    }
+}
+BENCHMARK(BM_TimeConstruct<ClockId::RealTime>);
+BENCHMARK(BM_TimeConstruct<ClockId::Monotonic>);
+BENCHMARK(BM_TimeConstruct<ClockId::BootTime>);
+
+void BM_SignalConstruct(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    stdplus::signal::block(SIGUSR1);
+    for (auto _ : state)
+    {
+        Signal source(event, SIGUSR1,
+                      [](Signal&, const struct signalfd_siginfo*) {});
+        benchmark::DoNotOptimize(source.get());
+    }
+}
+BENCHMARK(BM_SignalConstruct);
+
+void BM_ChildConstruct(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    stdplus::signal::block(SIGCHLD);
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        state.SkipWithError("fork failed");
+        return;
+    }
+    if (pid == 0)
+    {
+        pause();
+        _exit(0);
+    }
+    for (auto _ : state)
+    {
+        Child source(event, pid, WEXITED, [](Child&, const siginfo_t*) {});
+        benchmark::DoNotOptimize(source.get());
+    }
+    kill(pid, SIGKILL);
+    waitpid(pid, nullptr, 0);
+}
+BENCHMARK(BM_ChildConstruct);
+
+template <typename Source>
+void BM_EventConstruct(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    for (auto _ : state)
+    {
+        Source source(event, [](EventBase&) {});
+        benchmark::DoNotOptimize(source.get());
+    }
+}
+BENCHMARK(BM_EventConstruct<Defer>);
+BENCHMARK(BM_EventConstruct<Post>);
+BENCHMARK(BM_EventConstruct<Exit>);
+
+size_t heapUsed()
+{
+    return mallinfo2().uordblks;
+}
+
+size_t rssUsed()
+{
+    size_t size, resident;
+    std::ifstream statm("/proc/self/statm");
+    statm >> size >> resident;
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+/** @brief Measures the memory used per source, for state.range(0) Defer
+ *         sources, including the allocations made by sd-event itself
+ */
+void BM_SourceMemory(benchmark::State& state)
+{
+    const size_t count = state.range(0);
+    auto event = Event::get_new();
+    size_t heap = 0, rss = 0;
+    for (auto _ : state)
+    {
+        std::vector<Defer> sources;
+        sources.reserve(count);
+        const size_t heapBefore = heapUsed(), rssBefore = rssUsed();
+        for (size_t i = 0; i < count; ++i)
+        {
+            sources.emplace_back(event, [](EventBase&) {});
+        }
+        heap = heapUsed() - heapBefore;
+        rss = rssUsed() - rssBefore;
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["userdata_bytes"] = sizeof(detail::EventBaseData);
+    state.counters["heap_per_source"] = static_cast<double>(heap) / count;
+    state.counters["rss_per_source"] = static_cast<double>(rss) / count;
+}
+BENCHMARK(BM_SourceMemory)
+    ->Arg(100000)
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
+
+/** @brief Measures copying a source handle, which takes a reference on
+ *         both the source and its event, and reports the handle sizes
+ */
+void BM_HandleCopy(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    Defer source(event, [](EventBase&) {});
+    for (auto _ : state)
+    {
+        Defer copy(source);
+        benchmark::DoNotOptimize(copy.get());
+    }
+    state.counters["event_bytes"] = sizeof(Event);
+    state.counters["base_bytes"] = sizeof(Base);
+    state.counters["io_bytes"] = sizeof(IO);
+}
+BENCHMARK(BM_HandleCopy);
+
+/** @brief Measures moving a source handle, which must not touch the
+ *         reference counts
+ */
+void BM_HandleMove(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    Defer source(event, [](EventBase&) {});
+    for (auto _ : state)
+    {
+        Defer moved(std::move(source));
+        source = std::move(moved);
+        benchmark::DoNotOptimize(source.get());
+    }
+}
+BENCHMARK(BM_HandleMove);
+
+/** @brief Measures a complete loop iteration which dispatches a single
+ *         always pending Defer through Base::sourceCallback
+ */
+void BM_DeferDispatch(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    uint64_t dispatched = 0;
+    Defer source(event, [&](EventBase&) { dispatched++; });
+    source.set_enabled(Enabled::On);
+    for (auto _ : state)
+    {
+        event.run(std::nullopt);
+    }
+    state.counters["dispatched"] = dispatched;
+}
+BENCHMARK(BM_DeferDispatch);
+
+/** @brief BM_DeferDispatch with dispatch statistics collection enabled */
+void BM_DeferDispatchStats(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    uint64_t dispatched = 0;
+    Defer source(event, [&](EventBase&) { dispatched++; });
+    source.set_enabled(Enabled::On);
+    source.set_stats(true);
+    for (auto _ : state)
+    {
+        event.run(std::nullopt);
+    }
+    state.counters["dispatched"] = dispatched;
+}
+BENCHMARK(BM_DeferDispatchStats);
+
+/** @brief BM_DeferDispatch split into separately timed loop phases */
+void BM_DeferDispatchProfiled(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    uint64_t dispatched = 0;
+    Defer source(event, [&](EventBase&) { dispatched++; });
+    source.set_enabled(Enabled::On);
+    LoopProfile profile;
+    for (auto _ : state)
+    {
+        event.run(std::nullopt, profile);
+    }
+    state.counters["dispatched"] = dispatched;
+    state.counters["utilization"] = profile.utilization();
+}
+BENCHMARK(BM_DeferDispatchProfiled);
+
+/** @brief The same iteration as BM_DeferDispatch without sdeventplus, serving
+ *         as the baseline for the overhead added by the wrapper
+ */
+void BM_DeferDispatchRaw(benchmark::State& state)
+{
+    sd_event* event;
+    sd_event_new(&event);
+    uint64_t dispatched = 0;
+    sd_event_source* source;
+    sd_event_add_defer(
+        event, &source,
+        [](sd_event_source*, void* userdata) {
+            (*static_cast<uint64_t*>(userdata))++;
+            return 0;
+        },
+        &dispatched);
+    sd_event_source_set_enabled(source, SD_EVENT_ON);
+    for (auto _ : state)
+    {
+        sd_event_run(event, UINT64_MAX);
+    }
+    state.counters["dispatched"] = dispatched;
+    sd_event_source_unref(source);
+    sd_event_unref(event);
+}
+BENCHMARK(BM_DeferDispatchRaw);
+
+/** @brief Measures the wakeup path of an IO source, from the fd becoming
+ *         readable until the callback has consumed the event
+ */
+void BM_IODispatch(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    EventFd efd;
+    uint64_t dispatched = 0;
+    IO io(event, efd.fd, EPOLLIN, [&](IO&, int fd, uint32_t) {
+        uint64_t val;
+        benchmark::DoNotOptimize(read(fd, &val, sizeof(val)));
+        dispatched++;
+    });
+    for (auto _ : state)
+    {
+        uint64_t val = 1;
+        benchmark::DoNotOptimize(write(efd.fd, &val, sizeof(val)));
+        event.run(std::nullopt);
+    }
+    state.counters["dispatched"] = dispatched;
+}
+BENCHMARK(BM_IODispatch);
+
+/** @brief Same as BM_IODispatch but with the callback stored inline
+ */
+void BM_StaticIODispatch(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    EventFd efd;
+    uint64_t dispatched = 0;
+    StaticIO io(event, efd.fd, EPOLLIN, [&](IO&, int fd, uint32_t) {
+        uint64_t val;
+        benchmark::DoNotOptimize(read(fd, &val, sizeof(val)));
+        dispatched++;
+    });
+    for (auto _ : state)
+    {
+        uint64_t val = 1;
+        benchmark::DoNotOptimize(write(efd.fd, &val, sizeof(val)));
+        event.run(std::nullopt);
+    }
+    state.counters["dispatched"] = dispatched;
+}
+BENCHMARK(BM_StaticIODispatch);
+
+/** @brief Measures draining a burst of ready IO sources, one event per loop
+ *         iteration with run() or as a single run_batch() call
+ */
+template <bool batch>
+void BM_IOBurst(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    const size_t count = state.range(0);
+    std::vector<std::unique_ptr<EventFd>> efds;
+    std::vector<IO> ios;
+    uint64_t dispatched = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        efds.push_back(std::make_unique<EventFd>());
+        ios.emplace_back(event, efds.back()->fd, EPOLLIN,
+                         [&](IO&, int fd, uint32_t) {
+                             uint64_t val;
+                             benchmark::DoNotOptimize(
+                                 read(fd, &val, sizeof(val)));
+                             dispatched++;
+                         });
+    }
+    for (auto _ : state)
+    {
+        for (const auto& efd : efds)
+        {
+            uint64_t val = 1;
+            benchmark::DoNotOptimize(write(efd->fd, &val, sizeof(val)));
+        }
+        if constexpr (batch)
+        {
+            event.run_batch(count, std::nullopt);
+        }
+        else
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                event.run(std::nullopt);
+            }
+        }
+    }
+    state.SetItemsProcessed(dispatched);
+}
+BENCHMARK(BM_IOBurst<false>)->Arg(16)->Arg(256);
+BENCHMARK(BM_IOBurst<true>)->Arg(16)->Arg(256);
+
+/** @brief Measures rearming and dispatching an already elapsed time source
+ */
+void BM_TimeDispatch(benchmark::State& state)
+{
+    constexpr auto Id = ClockId::Monotonic;
+    auto event = Event::get_new();
+    uint64_t dispatched = 0;
+    Time<Id> source(event, Time<Id>::TimePoint(), std::chrono::microseconds{1},
+                    [&](Time<Id>&, Time<Id>::TimePoint) { dispatched++; });
+    for (auto _ : state)
+    {
+        source.set_enabled(Enabled::OneShot);
+        event.run(std::nullopt);
+    }
+    state.counters["dispatched"] = dispatched;
+}
+BENCHMARK(BM_TimeDispatch);
+
+/** @brief Same as BM_TimeDispatch but with the callback stored inline
+ */
+void BM_StaticTimeDispatch(benchmark::State& state)
+{
+    constexpr auto Id = ClockId::Monotonic;
+    auto event = Event::get_new();
+    uint64_t dispatched = 0;
+    auto callback = [&](Time<Id>&, Time<Id>::TimePoint) { dispatched++; };
+    StaticTime<Id, decltype(callback)> source(event, Time<Id>::TimePoint(),
+                                              std::chrono::microseconds{1},
+                                              std::move(callback));
+    for (auto _ : state)
+    {
+        source.set_enabled(Enabled::OneShot);
+        event.run(std::nullopt);
+    }
+    state.counters["dispatched"] = dispatched;
+}
+BENCHMARK(BM_StaticTimeDispatch);
+
+constexpr ClockId rearmClock = ClockId::Monotonic;
+
+/** @brief Measures rearming a time source through the wrapper, the path taken
+ *         by every utility::Timer restart. Compare with the Virtual and Raw
+ *         variants below, or rebuild with -Ddirect_sdevent=true, to see the
+ *         cost of the internal::SdEvent indirection.
+ */
+void BM_TimeRearm(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    auto time = Clock<rearmClock>(event).now() + std::chrono::hours{1};
+    Time<rearmClock> source(event, time, std::chrono::milliseconds{1},
+                            nullptr);
+    for (auto _ : state)
+    {
+        time += std::chrono::microseconds{1};
+        source.set_time(time);
+        source.set_enabled(Enabled::OneShot);
+    }
+}
+BENCHMARK(BM_TimeRearm);
+
+/** @brief Measures rearming a time source relative to the timestamp of the
+ *         loop iteration, without reading the clock through the wrapper
+ */
+void BM_TimeRearmRelative(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    Time<rearmClock> source(
+        event, Clock<rearmClock>(event).now() + std::chrono::hours{1},
+        std::chrono::milliseconds{1}, nullptr);
+    // Caches the iteration timestamp the relative time is based on
+    event.run(std::chrono::microseconds{0});
+    auto relative = std::chrono::hours{1} + std::chrono::microseconds{0};
+    for (auto _ : state)
+    {
+        relative += std::chrono::microseconds{1};
+        source.set_time_relative(relative);
+        source.set_enabled(Enabled::OneShot);
+    }
+}
+BENCHMARK(BM_TimeRearmRelative);
+
+/** @brief The rearm calls made virtually through internal::SdEvent */
+void BM_TimeRearmVirtual(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    auto time = Clock<rearmClock>(event).now() + std::chrono::hours{1};
+    Time<rearmClock> source(event, time, std::chrono::milliseconds{1},
+                            nullptr);
+    const internal::SdEvent* sdevent = &internal::sdevent_impl;
+    // Hide the implementation so the compiler cannot devirtualize the calls
+    benchmark::DoNotOptimize(sdevent);
+    uint64_t usec = SdEventDuration(time.time_since_epoch()).count();
+    for (auto _ : state)
+    {
+        sdevent->sd_event_source_set_time(source.get(), ++usec);
+        sdevent->sd_event_source_set_enabled(source.get(), SD_EVENT_ONESHOT);
+    }
+}
+BENCHMARK(BM_TimeRearmVirtual);
+
+/** @brief The rearm calls made directly to libsystemd */
+void BM_TimeRearmRaw(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    auto time = Clock<rearmClock>(event).now() + std::chrono::hours{1};
+    Time<rearmClock> source(event, time, std::chrono::milliseconds{1},
+                            nullptr);
+    uint64_t usec = SdEventDuration(time.time_since_epoch()).count();
+    for (auto _ : state)
+    {
+        sd_event_source_set_time(source.get(), ++usec);
+        sd_event_source_set_enabled(source.get(), SD_EVENT_ONESHOT);
+    }
+}
+BENCHMARK(BM_TimeRearmRaw);
+
+} // namespace
+} // namespace source
+} // namespace sdeventplus
+
+BENCHMARK_MAIN();
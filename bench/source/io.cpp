@@ -0,0 +1,161 @@
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+#include <benchmark/benchmark.h>
+
+namespace sdeventplus
+{
+namespace source
+{
+namespace
+{
+
+constexpr size_t chunkSize = 4096;
+
+struct Pipe
+{
+    static bool open(int fds[2])
+    {
+        return pipe2(fds, O_NONBLOCK | O_CLOEXEC) == 0;
+    }
+};
+
+struct UnixSocket
+{
+    static bool open(int fds[2])
+    {
+        return socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                          0, fds) == 0;
+    }
+};
+
+/** @brief Writes a burst of chunks into a pipe or unix socket and runs the
+ *         loop until the reading source consumed all of them
+ *
+ *  @param[in] state - The benchmark state, range(0) is the chunk count
+ *  @param[in] make  - Creates the source reading fds[0] into read
+ */
+template <typename Fds, typename Make>
+void runBurst(benchmark::State& state, Make&& make)
+{
+    const size_t chunks = state.range(0);
+    int fds[2];
+    if (!Fds::open(fds))
+    {
+        state.SkipWithError("open failed");
+        return;
+    }
+    auto event = Event::get_new();
+    size_t read = 0;
+    auto source = make(event, fds[0], read);
+    std::array<char, chunkSize> chunk{};
+    size_t total = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < chunks; ++i)
+        {
+            if (write(fds[1], chunk.data(), chunk.size()) !=
+                static_cast<ssize_t>(chunk.size()))
+            {
+                state.SkipWithError("write failed");
+                break;
+            }
+        }
+        total += chunks * chunk.size();
+        while (read < total)
+        {
+            event.run(std::nullopt);
+        }
+    }
+    state.SetBytesProcessed(total);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+/** @brief Level-triggered IO reading a single chunk per dispatch, so each
+ *         chunk costs a loop iteration
+ */
+template <typename Fds>
+void BM_IOReadOnce(benchmark::State& state)
+{
+    runBurst<Fds>(state, [](const Event& event, int fd, size_t& read) {
+        return IO(event, fd, EPOLLIN, [&read](IO&, int fd, uint32_t) {
+            std::array<char, chunkSize> buf;
+            ssize_t r = ::read(fd, buf.data(), buf.size());
+            if (r > 0)
+            {
+                read += r;
+            }
+        });
+    });
+}
+BENCHMARK(BM_IOReadOnce<Pipe>)->Arg(1)->Arg(16);
+BENCHMARK(BM_IOReadOnce<UnixSocket>)->Arg(1)->Arg(16);
+
+/** @brief Level-triggered IO reading until EAGAIN by hand
+ */
+template <typename Fds>
+void BM_IODrain(benchmark::State& state)
+{
+    runBurst<Fds>(state, [](const Event& event, int fd, size_t& read) {
+        return IO(event, fd, EPOLLIN, [&read](IO&, int fd, uint32_t) {
+            std::array<char, chunkSize> buf;
+            ssize_t r;
+            while ((r = ::read(fd, buf.data(), buf.size())) > 0)
+            {
+                read += r;
+            }
+        });
+    });
+}
+BENCHMARK(BM_IODrain<Pipe>)->Arg(1)->Arg(16);
+BENCHMARK(BM_IODrain<UnixSocket>)->Arg(1)->Arg(16);
+
+/** @brief Edge-triggered DrainIO reading until EAGAIN through its Reader
+ */
+template <typename Fds>
+void BM_DrainIO(benchmark::State& state)
+{
+    runBurst<Fds>(state, [](const Event& event, int fd, size_t& read) {
+        return DrainIO(event, fd, EPOLLIN,
+                       [&read](DrainIO&, DrainIO::Reader& reader, uint32_t) {
+                           std::array<char, chunkSize> buf;
+                           while (reader.read(buf.data(), buf.size()) > 0)
+                           {}
+                           read += reader.get_bytes();
+                       });
+    });
+}
+BENCHMARK(BM_DrainIO<Pipe>)->Arg(1)->Arg(16);
+BENCHMARK(BM_DrainIO<UnixSocket>)->Arg(1)->Arg(16);
+
+/** @brief Edge-triggered DrainIO reading a single chunk per dispatch and
+ *         relying on the source being re-armed
+ */
+template <typename Fds>
+void BM_DrainIOReadOnce(benchmark::State& state)
+{
+    runBurst<Fds>(state, [](const Event& event, int fd, size_t& read) {
+        return DrainIO(event, fd, EPOLLIN,
+                       [&read](DrainIO&, DrainIO::Reader& reader, uint32_t) {
+                           std::array<char, chunkSize> buf;
+                           read += reader.read(buf.data(), buf.size());
+                       });
+    });
+}
+BENCHMARK(BM_DrainIOReadOnce<Pipe>)->Arg(1)->Arg(16);
+BENCHMARK(BM_DrainIOReadOnce<UnixSocket>)->Arg(1)->Arg(16);
+
+} // namespace
+} // namespace source
+} // namespace sdeventplus
+
+BENCHMARK_MAIN();
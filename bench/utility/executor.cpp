@@ -0,0 +1,72 @@
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/profile.hpp>
+#include <sdeventplus/utility/executor.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace sdeventplus
+{
+namespace utility
+{
+namespace
+{
+
+/** @brief Measures tasks posted from a number of producer threads to be run
+ *         on the event loop. Reports the throughput and the post to execute
+ *         latency percentiles.
+ */
+void BM_ExecutorPost(benchmark::State& state)
+{
+    using clock = std::chrono::steady_clock;
+    constexpr size_t perProducer = 10000;
+    const size_t producers = state.range(0);
+    auto event = Event::get_new();
+    Executor executor(event);
+    Histogram latency;
+    size_t ran = 0;
+    for (auto _ : state)
+    {
+        const size_t target = ran + producers * perProducer;
+        std::vector<std::thread> threads;
+        for (size_t p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&]() {
+                for (size_t i = 0; i < perProducer; ++i)
+                {
+                    executor.post([&, posted = clock::now()]() {
+                        latency.record(clock::now() - posted);
+                        ran++;
+                    });
+                }
+            });
+        }
+        while (ran < target)
+        {
+            event.run(std::nullopt);
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+    state.SetItemsProcessed(ran);
+    state.counters["p50_ns"] = latency.percentile(0.5).count();
+    state.counters["p99_ns"] = latency.percentile(0.99).count();
+}
+BENCHMARK(BM_ExecutorPost)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace utility
+} // namespace sdeventplus
+
+BENCHMARK_MAIN();
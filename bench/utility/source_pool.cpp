@@ -0,0 +1,71 @@
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/time.hpp>
+#include <sdeventplus/utility/source_pool.hpp>
+
+#include <chrono>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+namespace sdeventplus
+{
+namespace utility
+{
+namespace
+{
+
+constexpr ClockId id = ClockId::Monotonic;
+
+/** @brief Measures arming and cancelling a request timeout on a pooled
+ *         source, the common case of a request completing in time
+ */
+void BM_TimePoolCancel(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    TimePool<id> pool(event);
+    for (auto _ : state)
+    {
+        auto ticket = pool.schedule_after(std::chrono::seconds{30},
+                                          std::chrono::milliseconds{1}, []() {});
+        benchmark::DoNotOptimize(pool.cancel(ticket));
+    }
+}
+BENCHMARK(BM_TimePoolCancel);
+
+/** @brief Baseline for BM_TimePoolCancel creating a new time source for
+ *         every timeout
+ */
+void BM_TimeSourceCancel(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    Clock<id> clock(event);
+    for (auto _ : state)
+    {
+        source::Time<id> source(event, clock.now() + std::chrono::seconds{30},
+                                std::chrono::milliseconds{1},
+                                [](source::Time<id>&, auto) {});
+    }
+}
+BENCHMARK(BM_TimeSourceCancel);
+
+/** @brief Measures scheduling and dispatching a pooled defer */
+void BM_DeferPoolDispatch(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    DeferPool pool(event);
+    uint64_t ran = 0;
+    for (auto _ : state)
+    {
+        pool.schedule([&]() { ran++; });
+        event.run(std::chrono::seconds{0});
+    }
+    state.counters["ran"] = ran;
+}
+BENCHMARK(BM_DeferPoolDispatch);
+
+} // namespace
+} // namespace utility
+} // namespace sdeventplus
+
+BENCHMARK_MAIN();
@@ -0,0 +1,96 @@
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/child.hpp>
+#include <sdeventplus/utility/spawner.hpp>
+#include <stdplus/signal.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+extern char** environ;
+
+namespace sdeventplus
+{
+namespace utility
+{
+namespace
+{
+
+const char* const trueArgv[] = {"true", nullptr};
+
+/** @brief Measures launching a burst of short-lived children through a
+ *         Spawner and waiting for all of them to exit
+ */
+void BM_SpawnerBurst(benchmark::State& state)
+{
+    const size_t count = state.range(0);
+    stdplus::signal::block(SIGCHLD);
+    auto event = Event::get_new();
+    Spawner spawner(event);
+    size_t exited = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            spawner.spawn(trueArgv,
+                          [&](pid_t, const siginfo_t*) { exited++; });
+        }
+        while (spawner.get_running() > 0)
+        {
+            event.run(std::nullopt);
+        }
+    }
+    state.SetItemsProcessed(exited);
+}
+BENCHMARK(BM_SpawnerBurst)->Arg(1)->Arg(64);
+
+/** @brief Baseline for BM_SpawnerBurst watching each child by pid, which
+ *         makes sd-event scan the children with waitid() on SIGCHLD
+ */
+void BM_PidChildBurst(benchmark::State& state)
+{
+    const size_t count = state.range(0);
+    stdplus::signal::block(SIGCHLD);
+    auto event = Event::get_new();
+    size_t exited = 0;
+    std::vector<source::Child> children;
+    children.reserve(count);
+    for (auto _ : state)
+    {
+        size_t running = count;
+        for (size_t i = 0; i < count; ++i)
+        {
+            pid_t pid;
+            if (posix_spawnp(&pid, trueArgv[0], nullptr, nullptr,
+                             const_cast<char* const*>(trueArgv), environ) != 0)
+            {
+                state.SkipWithError("posix_spawnp failed");
+                return;
+            }
+            children.emplace_back(event, pid, WEXITED,
+                                  [&](source::Child&, const siginfo_t*) {
+                                      running--;
+                                      exited++;
+                                  });
+        }
+        while (running > 0)
+        {
+            event.run(std::nullopt);
+        }
+        children.clear();
+    }
+    state.SetItemsProcessed(exited);
+}
+BENCHMARK(BM_PidChildBurst)->Arg(1)->Arg(64);
+
+} // namespace
+} // namespace utility
+} // namespace sdeventplus
+
+BENCHMARK_MAIN();
@@ -0,0 +1,125 @@
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+namespace sdeventplus
+{
+namespace utility
+{
+namespace
+{
+
+constexpr ClockId testClock = ClockId::Monotonic;
+using TestTimer = Timer<testClock>;
+
+void BM_TimerConstruct(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    for (auto _ : state)
+    {
+        TestTimer timer(event, nullptr, std::chrono::seconds{1});
+        benchmark::DoNotOptimize(&timer);
+    }
+}
+BENCHMARK(BM_TimerConstruct);
+
+/** @brief Measures the watchdog style restart of a oneshot timer */
+void BM_TimerRestartOnce(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    TestTimer timer(event, nullptr);
+    for (auto _ : state)
+    {
+        timer.restartOnce(std::chrono::seconds{1});
+    }
+}
+BENCHMARK(BM_TimerRestartOnce);
+
+/** @brief Measures a watchdog restarted for every message handled in a loop
+ *         iteration, where all restarts compute the same expiration
+ */
+void BM_TimerRestartOnceSameIteration(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    TestTimer timer(event, nullptr);
+    // Caches the iteration timestamp returned by sd_event_now()
+    event.run(std::chrono::microseconds{0});
+    for (auto _ : state)
+    {
+        timer.restartOnce(std::chrono::seconds{1});
+    }
+}
+BENCHMARK(BM_TimerRestartOnceSameIteration);
+
+/** @brief Measures the periodic rearm and dispatch of a timer which is
+ *         always expired
+ */
+void BM_TimerDispatch(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    uint64_t dispatched = 0;
+    TestTimer timer(
+        event, [&](TestTimer&) { dispatched++; }, std::chrono::microseconds{0},
+        std::chrono::microseconds{1});
+    for (auto _ : state)
+    {
+        event.run(std::nullopt);
+    }
+    state.counters["dispatched"] = dispatched;
+}
+BENCHMARK(BM_TimerDispatch);
+
+/** @brief Measures how far a 10ms periodic timer slipped from its original
+ *         phase after 100 ticks whose callbacks each take 1ms, without and
+ *         with a fixed rate
+ */
+void BM_TimerPhaseDrift(benchmark::State& state)
+{
+    constexpr std::chrono::milliseconds interval{10};
+    constexpr uint64_t ticks = 100;
+    auto event = Event::get_new();
+    std::chrono::microseconds drift{};
+    for (auto _ : state)
+    {
+        uint64_t ran = 0;
+        const auto start = Clock<testClock>(event).now();
+        typename TestTimer::Duration last{};
+        TestTimer timer(
+            event,
+            [&](TestTimer&) {
+                ran++;
+                last = Clock<testClock>(event).now() - start;
+                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            },
+            interval);
+        if (state.range(0))
+        {
+            timer.setFixedRate(CatchUp::Skip);
+        }
+        while (ran < ticks)
+        {
+            event.run(std::nullopt);
+        }
+        drift = last - interval * ticks;
+    }
+    state.counters["drift_us"] = drift.count();
+}
+BENCHMARK(BM_TimerPhaseDrift)
+    ->Arg(0)
+    ->Arg(1)
+    ->Iterations(1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace utility
+} // namespace sdeventplus
+
+BENCHMARK_MAIN();
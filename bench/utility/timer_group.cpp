@@ -0,0 +1,103 @@
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+#include <sdeventplus/utility/timer_group.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace sdeventplus
+{
+namespace utility
+{
+namespace
+{
+
+constexpr ClockId testClock = ClockId::Monotonic;
+constexpr std::chrono::milliseconds interval{100};
+constexpr std::chrono::milliseconds runtime{1000};
+using TestTimer = Timer<testClock>;
+using TestGroup = TimerGroup<testClock>;
+
+/** @brief Runs the loop for the benchmark runtime, counting the wakeups */
+uint64_t runLoop(const Event& event)
+{
+    uint64_t wakeups = 0;
+    const auto end = std::chrono::steady_clock::now() + runtime;
+    while (std::chrono::steady_clock::now() < end)
+    {
+        wakeups += event.run(std::chrono::milliseconds{10}) > 0;
+    }
+    return wakeups;
+}
+
+/** @brief Measures the wakeups of state.range(0) independent polling timers
+ *         started a millisecond apart
+ */
+void BM_TimerWakeups(benchmark::State& state)
+{
+    const size_t count = state.range(0);
+    auto event = Event::get_new();
+    uint64_t dispatches = 0, wakeups = 0;
+    for (auto _ : state)
+    {
+        std::vector<std::unique_ptr<TestTimer>> timers;
+        for (size_t i = 0; i < count; ++i)
+        {
+            timers.push_back(std::make_unique<TestTimer>(
+                event, [&](TestTimer&) { dispatches++; }, interval));
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+        wakeups += runLoop(event);
+    }
+    state.counters["wakeups"] =
+        benchmark::Counter(wakeups, benchmark::Counter::kIsRate);
+    state.counters["ratio"] = static_cast<double>(dispatches) / wakeups;
+}
+BENCHMARK(BM_TimerWakeups)
+    ->Arg(16)
+    ->Arg(64)
+    ->Iterations(1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+/** @brief Measures the wakeups of the same timers sharing a group with a
+ *         slack of state.range(1) milliseconds
+ */
+void BM_TimerGroupWakeups(benchmark::State& state)
+{
+    const size_t count = state.range(0);
+    auto event = Event::get_new();
+    TestGroup group(event, std::chrono::milliseconds{state.range(1)});
+    uint64_t wakeups = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            group.add(interval, []() {});
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+        wakeups += runLoop(event);
+    }
+    state.counters["wakeups"] =
+        benchmark::Counter(wakeups, benchmark::Counter::kIsRate);
+    state.counters["ratio"] = group.get_stats().coalescingRatio();
+}
+BENCHMARK(BM_TimerGroupWakeups)
+    ->ArgsProduct({{16, 64}, {5, 20}})
+    ->Iterations(1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace utility
+} // namespace sdeventplus
+
+BENCHMARK_MAIN();
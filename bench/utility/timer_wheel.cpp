@@ -0,0 +1,151 @@
+#include <malloc.h>
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+#include <sdeventplus/utility/timer_wheel.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace sdeventplus
+{
+namespace utility
+{
+namespace
+{
+
+constexpr ClockId testClock = ClockId::Monotonic;
+using TestTimer = Timer<testClock>;
+using TestWheel = TimerWheel<testClock>;
+
+size_t heapUsed()
+{
+    return mallinfo2().uordblks;
+}
+
+/** @brief Measures the heap used per armed timer, for state.range(0) timers
+ *         each owning their own time source
+ */
+void BM_TimerMemory(benchmark::State& state)
+{
+    const size_t count = state.range(0);
+    auto event = Event::get_new();
+    size_t used = 0;
+    for (auto _ : state)
+    {
+        const size_t before = heapUsed();
+        std::vector<std::unique_ptr<TestTimer>> timers;
+        timers.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            timers.push_back(std::make_unique<TestTimer>(
+                event, nullptr, std::chrono::seconds{1 + i % 60}));
+        }
+        used = heapUsed() - before;
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["bytes_per_timer"] = static_cast<double>(used) / count;
+}
+BENCHMARK(BM_TimerMemory)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+/** @brief Measures the heap used per armed timer, for state.range(0) timers
+ *         sharing the single time source of a wheel
+ */
+void BM_TimerWheelMemory(benchmark::State& state)
+{
+    const size_t count = state.range(0);
+    auto event = Event::get_new();
+    size_t used = 0;
+    for (auto _ : state)
+    {
+        const size_t before = heapUsed();
+        auto wheel = std::make_unique<TestWheel>(event);
+        for (size_t i = 0; i < count; ++i)
+        {
+            wheel->add(std::chrono::seconds{1 + i % 60},
+                       [](TestWheel::Handle) {});
+        }
+        used = heapUsed() - before;
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["bytes_per_timer"] = static_cast<double>(used) / count;
+}
+BENCHMARK(BM_TimerWheelMemory)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+/** @brief Measures adding and cancelling a timer next to state.range(0)
+ *         armed timers
+ */
+void BM_TimerWheelAddCancel(benchmark::State& state)
+{
+    auto event = Event::get_new();
+    TestWheel wheel(event);
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        wheel.add(std::chrono::seconds{1 + i % 60}, [](TestWheel::Handle) {});
+    }
+    for (auto _ : state)
+    {
+        wheel.cancel(
+            wheel.add(std::chrono::seconds{30}, [](TestWheel::Handle) {}));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimerWheelAddCancel)->Arg(0)->Arg(100000);
+
+/** @brief Measures the watchdog style restart of one of state.range(0)
+ *         armed timers, each owning a time source
+ */
+void BM_TimerRearmChurn(benchmark::State& state)
+{
+    const size_t count = state.range(0);
+    auto event = Event::get_new();
+    std::vector<std::unique_ptr<TestTimer>> timers;
+    for (size_t i = 0; i < count; ++i)
+    {
+        timers.push_back(std::make_unique<TestTimer>(
+            event, nullptr, std::chrono::seconds{1 + i % 60}));
+    }
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        timers[i]->restartOnce(std::chrono::seconds{1 + i % 60});
+        i = (i + 1) % count;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimerRearmChurn)->Arg(1000)->Arg(100000);
+
+/** @brief Measures the watchdog style restart of one of state.range(0)
+ *         timers armed on a wheel
+ */
+void BM_TimerWheelRearmChurn(benchmark::State& state)
+{
+    const size_t count = state.range(0);
+    auto event = Event::get_new();
+    TestWheel wheel(event);
+    std::vector<TestWheel::Handle> handles;
+    for (size_t i = 0; i < count; ++i)
+    {
+        handles.push_back(wheel.add(std::chrono::seconds{1 + i % 60},
+                                    [](TestWheel::Handle) {}));
+    }
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        wheel.rearm(handles[i], std::chrono::seconds{1 + i % 60});
+        i = (i + 1) % count;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimerWheelRearmChurn)->Arg(1000)->Arg(100000);
+
+} // namespace
+} // namespace utility
+} // namespace sdeventplus
+
+BENCHMARK_MAIN();
@@ -0,0 +1,68 @@
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+#include <sdeventplus/utility/work_queue.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace sdeventplus
+{
+namespace utility
+{
+namespace
+{
+
+/** @brief Measures running a burst of small deferred tasks through a single
+ *         WorkQueue
+ */
+void BM_WorkQueuePost(benchmark::State& state)
+{
+    const size_t count = state.range(0);
+    auto event = Event::get_new();
+    WorkQueue queue(event, count);
+    size_t ran = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            queue.post([&]() { ran++; });
+        }
+        event.run(std::nullopt);
+    }
+    state.SetItemsProcessed(ran);
+}
+BENCHMARK(BM_WorkQueuePost)->Arg(16)->Arg(1024);
+
+/** @brief Baseline for BM_WorkQueuePost creating one Defer source per task
+ */
+void BM_DeferPerTask(benchmark::State& state)
+{
+    const size_t count = state.range(0);
+    auto event = Event::get_new();
+    size_t ran = 0;
+    std::vector<source::Defer> defers;
+    defers.reserve(count);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            defers.emplace_back(event, [&](source::EventBase& source) {
+                ran++;
+                source.set_enabled(source::Enabled::Off);
+            });
+        }
+        event.run_batch(count, std::nullopt);
+        defers.clear();
+    }
+    state.SetItemsProcessed(ran);
+}
+BENCHMARK(BM_DeferPerTask)->Arg(16)->Arg(1024);
+
+} // namespace
+} // namespace utility
+} // namespace sdeventplus
+
+BENCHMARK_MAIN();
@@ -1,8 +1,11 @@
 #include <sdeventplus/clock.hpp>
 #include <sdeventplus/exception.hpp>
+#include <sdeventplus/internal/call.hpp>
 #include <sdeventplus/internal/cexec.hpp>
 #include <sdeventplus/internal/sdevent.hpp>
 
+#include <expected>
+#include <system_error>
 #include <utility>
 
 namespace sdeventplus
@@ -20,12 +23,29 @@ template <ClockId Id>
 typename Clock<Id>::time_point Clock<Id>::now() const
 {
     uint64_t now;
-    SDEVENTPLUS_CHECK("sd_event_now",
-                      event.getSdEvent()->sd_event_now(
-                          event.get(), static_cast<clockid_t>(Id), &now));
+    SDEVENTPLUS_CHECK(
+        "sd_event_now",
+        internal::call<&internal::SdEvent::sd_event_now>(
+            event.getSdEvent(), event.get(), static_cast<clockid_t>(Id), &now));
     return time_point(SdEventDuration(now));
 }
 
+template <ClockId Id>
+std::expected<typename Clock<Id>::time_point, std::error_code>
+    Clock<Id>::try_now() const noexcept
+{
+    if (event.get_or_null() == nullptr)
+    {
+        return internal::movedFrom();
+    }
+    uint64_t now;
+    return internal::expect(
+               internal::call<&internal::SdEvent::sd_event_now>(
+                   event.getSdEvent(), event.get_or_null(),
+                   static_cast<clockid_t>(Id), &now))
+        .transform([&](int) { return time_point(SdEventDuration(now)); });
+}
+
 template class Clock<ClockId::RealTime>;
 template class Clock<ClockId::Monotonic>;
 template class Clock<ClockId::BootTime>;
@@ -6,6 +6,8 @@
 #include <chrono>
 #include <cstdint>
 #include <ctime>
+#include <expected>
+#include <system_error>
 #include <type_traits>
 
 namespace sdeventplus
@@ -52,6 +54,14 @@ class Clock
      */
     time_point now() const;
 
+    /** @brief Gets the current time of the clock without throwing
+     *
+     * @return The std::chrono::time_point representing the current time,
+     *         or the error reported by sd_event,
+     *         std::errc::bad_file_descriptor if the Event was moved from
+     */
+    std::expected<time_point, std::error_code> try_now() const noexcept;
+
   private:
     Event event;
 };
@@ -0,0 +1,79 @@
+#include <sys/wait.h>
+
+#include <sdeventplus/coroutine.hpp>
+
+namespace sdeventplus
+{
+namespace detail
+{
+
+IoReady::IoReady(const Event& event, int fd, uint32_t events) :
+    SourceAwaiter(event), fd(fd), events(events)
+{}
+
+void IoReady::await_suspend(std::coroutine_handle<> h)
+{
+    handle = h;
+    source.emplace(event, fd, events,
+                   [this](source::IO&, int, uint32_t revents) {
+                       complete(revents);
+                   });
+    // IO sources default to Enabled::On, only a single wakeup is wanted
+    source->set_enabled(source::Enabled::OneShot);
+}
+
+template <ClockId Id>
+SleepFor<Id>::SleepFor(const Event& event,
+                       typename Clock<Id>::duration duration,
+                       typename source::Time<Id>::Accuracy accuracy) :
+    SourceAwaiter<source::Time<Id>, typename Clock<Id>::time_point>(event),
+    duration(duration), accuracy(accuracy)
+{}
+
+template <ClockId Id>
+void SleepFor<Id>::await_suspend(std::coroutine_handle<> h)
+{
+    this->handle = h;
+    this->source.emplace(
+        this->event, Clock<Id>(this->event).now() + duration, accuracy,
+        [this](source::Time<Id>&, typename Clock<Id>::time_point time) {
+            this->complete(time);
+        });
+}
+
+template class SleepFor<ClockId::RealTime>;
+template class SleepFor<ClockId::Monotonic>;
+template class SleepFor<ClockId::BootTime>;
+template class SleepFor<ClockId::RealTimeAlarm>;
+template class SleepFor<ClockId::BootTimeAlarm>;
+
+ChildExit::ChildExit(const Event& event, pid_t pid) :
+    SourceAwaiter(event), pid(pid)
+{}
+
+void ChildExit::await_suspend(std::coroutine_handle<> h)
+{
+    handle = h;
+    source.emplace(event, pid, WEXITED,
+                   [this](source::Child&, const siginfo_t* si) {
+                       complete(*si);
+                   });
+}
+
+NextSignal::NextSignal(const Event& event, int sig) :
+    SourceAwaiter(event), sig(sig)
+{}
+
+void NextSignal::await_suspend(std::coroutine_handle<> h)
+{
+    handle = h;
+    source.emplace(event, sig,
+                   [this](source::Signal&, const struct signalfd_siginfo* si) {
+                       complete(*si);
+                   });
+    // Signal sources default to Enabled::On, only a single wakeup is wanted
+    source->set_enabled(source::Enabled::OneShot);
+}
+
+} // namespace detail
+} // namespace sdeventplus
@@ -0,0 +1,395 @@
+#pragma once
+
+#include <signal.h>
+#include <sys/signalfd.h>
+#include <sys/types.h>
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/child.hpp>
+#include <sdeventplus/source/io.hpp>
+#include <sdeventplus/source/signal.hpp>
+#include <sdeventplus/source/time.hpp>
+
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace sdeventplus
+{
+
+template <typename T = void>
+class task;
+
+namespace detail
+{
+
+/** @brief The promise state shared by all task types */
+class TaskPromiseBase
+{
+  public:
+    /** @brief Resumes the awaiting coroutine, if any, when the task ends */
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        template <typename Promise>
+        std::coroutine_handle<>
+            await_suspend(std::coroutine_handle<Promise> h) const noexcept
+        {
+            auto continuation = h.promise().continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    void unhandled_exception() noexcept
+    {
+        exception = std::current_exception();
+    }
+
+    /** @brief The coroutine awaiting the result of this task */
+    std::coroutine_handle<> continuation;
+    /** @brief The exception which ended the task */
+    std::exception_ptr exception;
+};
+
+template <typename T>
+class TaskPromise : public TaskPromiseBase
+{
+  public:
+    task<T> get_return_object();
+
+    void return_value(T v)
+    {
+        value.emplace(std::move(v));
+    }
+
+    T result()
+    {
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+        return std::move(*value);
+    }
+
+  private:
+    std::optional<T> value;
+};
+
+template <>
+class TaskPromise<void> : public TaskPromiseBase
+{
+  public:
+    task<void> get_return_object();
+
+    void return_void() const noexcept {}
+
+    void result()
+    {
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+};
+
+} // namespace detail
+
+/** @class task<T>
+ *  @brief A lazily started coroutine producing a T
+ *  @details The task does not run until it is either awaited from another
+ *           coroutine or started with start(). Awaiting a task resumes the
+ *           awaiting coroutine once the task finished, returning its result
+ *           or rethrowing its exception. Destroying a task which is
+ *           suspended on one of the sdeventplus awaiters removes the
+ *           underlying source, so it is never resumed.
+ */
+template <typename T>
+class task
+{
+  public:
+    using promise_type = detail::TaskPromise<T>;
+
+    task(task&& other) noexcept : handle(std::exchange(other.handle, nullptr))
+    {}
+
+    task& operator=(task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+
+    task(const task&) = delete;
+    task& operator=(const task&) = delete;
+
+    ~task()
+    {
+        reset();
+    }
+
+    /** @brief Runs the task until its first suspension point
+     *         Only valid for a task which was never started or awaited
+     */
+    void start()
+    {
+        handle.resume();
+    }
+
+    /** @brief Whether or not the task ran to completion
+     *
+     *  @return 'true' if the task finished, 'false' otherwise
+     */
+    bool done() const
+    {
+        return handle && handle.done();
+    }
+
+    /** @brief Gets the result of a finished task
+     *
+     *  @throws Any exception thrown from the task
+     *  @return The value returned by the task
+     */
+    T get()
+    {
+        return handle.promise().result();
+    }
+
+    /** @brief Runs the task from the awaiting coroutine, resuming it with
+     *         the result once the task finished
+     */
+    auto operator co_await() && noexcept
+    {
+        struct Awaiter
+        {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept
+            {
+                return handle.done();
+            }
+
+            std::coroutine_handle<>
+                await_suspend(std::coroutine_handle<> awaiting) noexcept
+            {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+
+            T await_resume()
+            {
+                return handle.promise().result();
+            }
+        };
+        return Awaiter{handle};
+    }
+
+  private:
+    std::coroutine_handle<promise_type> handle;
+
+    explicit task(std::coroutine_handle<promise_type> handle) : handle(handle)
+    {}
+
+    void reset()
+    {
+        if (handle)
+        {
+            handle.destroy();
+            handle = nullptr;
+        }
+    }
+
+    friend promise_type;
+};
+
+namespace detail
+{
+
+template <typename T>
+task<T> TaskPromise<T>::get_return_object()
+{
+    return task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline task<void> TaskPromise<void>::get_return_object()
+{
+    return task<void>(
+        std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+/** @brief Common state of the awaiters suspending on a single source
+ *         dispatch. The awaiter lives in the coroutine frame and the source
+ *         callback only captures a pointer to it, which fits the callback
+ *         small buffer, so a wait allocates nothing beyond the source.
+ */
+template <typename Source, typename Result>
+class SourceAwaiter
+{
+  public:
+    SourceAwaiter(const SourceAwaiter&) = delete;
+    SourceAwaiter& operator=(const SourceAwaiter&) = delete;
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    Result await_resume()
+    {
+        return std::move(*result);
+    }
+
+  protected:
+    Event event;
+    std::coroutine_handle<> handle;
+    std::optional<Source> source;
+    std::optional<Result> result;
+
+    explicit SourceAwaiter(const Event& event) : event(event) {}
+
+    /** @brief Stores the result and resumes the suspended coroutine
+     *         Must be the last use of the awaiter in the source callback,
+     *         as the coroutine destroys it when resuming.
+     */
+    void complete(Result r)
+    {
+        result.emplace(std::move(r));
+        handle.resume();
+    }
+};
+
+/** @brief Awaiter of io_ready() */
+class IoReady : public SourceAwaiter<source::IO, uint32_t>
+{
+  public:
+    IoReady(const Event& event, int fd, uint32_t events);
+
+    void await_suspend(std::coroutine_handle<> h);
+
+  private:
+    int fd;
+    uint32_t events;
+};
+
+/** @brief Awaiter of sleep_for() */
+template <ClockId Id>
+class SleepFor :
+    public SourceAwaiter<source::Time<Id>, typename Clock<Id>::time_point>
+{
+  public:
+    SleepFor(const Event& event, typename Clock<Id>::duration duration,
+             typename source::Time<Id>::Accuracy accuracy);
+
+    void await_suspend(std::coroutine_handle<> h);
+
+  private:
+    typename Clock<Id>::duration duration;
+    typename source::Time<Id>::Accuracy accuracy;
+};
+
+/** @brief Awaiter of child_exit() */
+class ChildExit : public SourceAwaiter<source::Child, siginfo_t>
+{
+  public:
+    ChildExit(const Event& event, pid_t pid);
+
+    void await_suspend(std::coroutine_handle<> h);
+
+  private:
+    pid_t pid;
+};
+
+/** @brief Awaiter of next_signal() */
+class NextSignal : public SourceAwaiter<source::Signal, signalfd_siginfo>
+{
+  public:
+    NextSignal(const Event& event, int sig);
+
+    void await_suspend(std::coroutine_handle<> h);
+
+  private:
+    int sig;
+};
+
+} // namespace detail
+
+/** @brief Suspends the coroutine until the file descriptor reports one of
+ *         the requested events. See source::IO.
+ *
+ *  @param[in] event  - The event loop resuming the coroutine
+ *  @param[in] fd     - The file descriptor producing the events
+ *  @param[in] events - The epoll event mask to wait for
+ *  @throws SdEventError for underlying sd_event errors when awaited
+ *  @return An awaitable producing the received epoll events
+ */
+inline detail::IoReady io_ready(const Event& event, int fd, uint32_t events)
+{
+    return detail::IoReady(event, fd, events);
+}
+
+/** @brief Suspends the coroutine for the given duration. See source::Time.
+ *
+ *  @param[in] event    - The event loop resuming the coroutine
+ *  @param[in] duration - The time to sleep
+ *  @param[in] accuracy - Optional amount of error tolerable in the wakeup
+ *  @throws SdEventError for underlying sd_event errors when awaited
+ *  @return An awaitable producing the time the sleep elapsed at
+ */
+template <ClockId Id>
+detail::SleepFor<Id> sleep_for(const Event& event,
+                               typename Clock<Id>::duration duration,
+                               typename source::Time<Id>::Accuracy accuracy =
+                                   std::chrono::milliseconds{1})
+{
+    return detail::SleepFor<Id>(event, duration, accuracy);
+}
+
+/** @brief Suspends the coroutine until the child exits. See source::Child,
+ *         SIGCHLD needs to be blocked.
+ *
+ *  @param[in] event - The event loop resuming the coroutine
+ *  @param[in] pid   - The pid of the child to wait for
+ *  @throws SdEventError for underlying sd_event errors when awaited
+ *  @return An awaitable producing the exit information of the child
+ */
+inline detail::ChildExit child_exit(const Event& event, pid_t pid)
+{
+    return detail::ChildExit(event, pid);
+}
+
+/** @brief Suspends the coroutine until the signal is received.
+ *         See source::Signal, the signal needs to be blocked.
+ *
+ *  @param[in] event - The event loop resuming the coroutine
+ *  @param[in] sig   - The signal to wait for
+ *  @throws SdEventError for underlying sd_event errors when awaited
+ *  @return An awaitable producing the received signal information
+ */
+inline detail::NextSignal next_signal(const Event& event, int sig)
+{
+    return detail::NextSignal(event, sig);
+}
+
+} // namespace sdeventplus
@@ -1,10 +1,16 @@
 #include <systemd/sd-event.h>
 
 #include <sdeventplus/event.hpp>
+#include <sdeventplus/internal/call.hpp>
 #include <sdeventplus/internal/cexec.hpp>
 #include <sdeventplus/internal/sdevent.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <expected>
 #include <functional>
+#include <optional>
+#include <system_error>
 #include <type_traits>
 #include <utility>
 
@@ -12,35 +18,87 @@ namespace sdeventplus
 {
 
 Event::Event(sd_event* event, const internal::SdEvent* sdevent) :
-    sdevent(sdevent), event(event, sdevent, true)
+    event(internal::call<&internal::SdEvent::sd_event_ref>(sdevent, event)),
+    sdevent(sdevent), owned(true)
 {}
 
 Event::Event(sd_event* event, std::false_type,
              const internal::SdEvent* sdevent) :
-    sdevent(sdevent), event(std::move(event), sdevent, true)
+    event(event), sdevent(sdevent), owned(true)
 {}
 
 Event::Event(const Event& other, sdeventplus::internal::NoOwn) :
-    sdevent(other.sdevent), event(other.get(), other.getSdEvent(), false)
+    event(other.get()), sdevent(other.sdevent), owned(false)
 {}
 
+Event::Event(const Event& other) : event(nullptr), sdevent(other.sdevent)
+{
+    ref(other);
+}
+
+Event& Event::operator=(const Event& other)
+{
+    if (this != &other)
+    {
+        drop();
+        sdevent = other.sdevent;
+        ref(other);
+    }
+    return *this;
+}
+
+Event::Event(Event&& other) noexcept :
+    event(std::exchange(other.event, nullptr)), sdevent(other.sdevent),
+    owned(std::exchange(other.owned, false))
+{}
+
+Event& Event::operator=(Event&& other) noexcept
+{
+    if (this != &other)
+    {
+        drop();
+        event = std::exchange(other.event, nullptr);
+        sdevent = other.sdevent;
+        owned = std::exchange(other.owned, false);
+    }
+    return *this;
+}
+
+Event::~Event()
+{
+    drop();
+}
+
 Event Event::get_new(const internal::SdEvent* sdevent)
 {
     sd_event* event = nullptr;
-    SDEVENTPLUS_CHECK("sd_event_new", sdevent->sd_event_new(&event));
+    SDEVENTPLUS_CHECK(
+        "sd_event_new",
+        internal::call<&internal::SdEvent::sd_event_new>(sdevent, &event));
     return Event(event, std::false_type(), sdevent);
 }
 
 Event Event::get_default(const internal::SdEvent* sdevent)
 {
     sd_event* event = nullptr;
-    SDEVENTPLUS_CHECK("sd_event_default", sdevent->sd_event_default(&event));
+    SDEVENTPLUS_CHECK(
+        "sd_event_default",
+        internal::call<&internal::SdEvent::sd_event_default>(sdevent, &event));
     return Event(event, std::false_type(), sdevent);
 }
 
 sd_event* Event::get() const
 {
-    return event.value();
+    if (event == nullptr)
+    {
+        throw std::bad_optional_access();
+    }
+    return event;
+}
+
+sd_event* Event::get_or_null() const noexcept
+{
+    return event;
 }
 
 const internal::SdEvent* Event::getSdEvent() const
@@ -50,76 +108,273 @@ const internal::SdEvent* Event::getSdEvent() const
 
 int Event::prepare() const
 {
-    return SDEVENTPLUS_CHECK("sd_event_prepare",
-                             sdevent->sd_event_prepare(get()));
+    return SDEVENTPLUS_CHECK(
+        "sd_event_prepare",
+        internal::call<&internal::SdEvent::sd_event_prepare>(sdevent, get()));
 }
 
 int Event::wait(MaybeTimeout timeout) const
 {
     // An unsigned -1 timeout value means infinity in sd_event
     uint64_t timeout_usec = timeout ? timeout->count() : -1;
-    return SDEVENTPLUS_CHECK("sd_event_wait",
-                             sdevent->sd_event_wait(get(), timeout_usec));
+    return SDEVENTPLUS_CHECK(
+        "sd_event_wait",
+        internal::call<&internal::SdEvent::sd_event_wait>(
+            sdevent, get(), timeout_usec));
 }
 
 int Event::dispatch() const
 {
-    return SDEVENTPLUS_CHECK("sd_event_dispatch",
-                             sdevent->sd_event_dispatch(get()));
+    return SDEVENTPLUS_CHECK(
+        "sd_event_dispatch",
+        internal::call<&internal::SdEvent::sd_event_dispatch>(sdevent, get()));
 }
 
 int Event::run(MaybeTimeout timeout) const
 {
     // An unsigned -1 timeout value means infinity in sd_event
     uint64_t timeout_usec = timeout ? timeout->count() : -1;
-    return SDEVENTPLUS_CHECK("sd_event_run",
-                             sdevent->sd_event_run(get(), timeout_usec));
+    return SDEVENTPLUS_CHECK(
+        "sd_event_run",
+        internal::call<&internal::SdEvent::sd_event_run>(
+            sdevent, get(), timeout_usec));
+}
+
+std::expected<int, std::error_code>
+    Event::try_run(MaybeTimeout timeout) const noexcept
+{
+    if (event == nullptr)
+    {
+        return internal::movedFrom();
+    }
+    // An unsigned -1 timeout value means infinity in sd_event
+    uint64_t timeout_usec = timeout ? timeout->count() : -1;
+    return internal::expect(internal::call<&internal::SdEvent::sd_event_run>(
+        sdevent, event, timeout_usec));
+}
+
+int Event::run(MaybeTimeout timeout, LoopProfile& profile) const
+{
+    bool finished;
+    return runProfiled(timeout, profile, finished);
+}
+
+size_t Event::run_batch(size_t max_events, MaybeTimeout budget,
+                        MaybeTimeout timeout) const
+{
+    bool finished;
+    return runBatch(max_events, budget, timeout, finished);
 }
 
 int Event::loop() const
 {
-    return SDEVENTPLUS_CHECK("sd_event_loop", sdevent->sd_event_loop(get()));
+    return SDEVENTPLUS_CHECK(
+        "sd_event_loop",
+        internal::call<&internal::SdEvent::sd_event_loop>(sdevent, get()));
+}
+
+int Event::loop(LoopProfile& profile) const
+{
+    bool finished = false;
+    while (!finished)
+    {
+        runProfiled(std::nullopt, profile, finished);
+    }
+    return get_exit_code();
+}
+
+int Event::loop_batch(size_t max_events, MaybeTimeout budget) const
+{
+    bool finished = false;
+    while (!finished)
+    {
+        runBatch(max_events, budget, std::nullopt, finished);
+    }
+    return get_exit_code();
+}
+
+int Event::loop_busy_poll(Timeout window) const
+{
+    return loopBusyPoll(window, nullptr);
+}
+
+int Event::loop_busy_poll(Timeout window, LoopProfile& profile) const
+{
+    return loopBusyPoll(window, &profile);
 }
 
 void Event::exit(int code) const
 {
-    SDEVENTPLUS_CHECK("sd_event_exit", sdevent->sd_event_exit(get(), code));
+    SDEVENTPLUS_CHECK(
+        "sd_event_exit",
+        internal::call<&internal::SdEvent::sd_event_exit>(sdevent, get(),
+                                                          code));
+}
+
+std::expected<void, std::error_code> Event::try_exit(int code) const noexcept
+{
+    if (event == nullptr)
+    {
+        return internal::movedFrom();
+    }
+    return internal::expect(internal::call<&internal::SdEvent::sd_event_exit>(
+                                sdevent, event, code))
+        .transform([](int) {});
 }
 
 int Event::get_exit_code() const
 {
     int code;
-    SDEVENTPLUS_CHECK("sd_event_get_exit_code",
-                      sdevent->sd_event_get_exit_code(get(), &code));
+    SDEVENTPLUS_CHECK(
+        "sd_event_get_exit_code",
+        internal::call<&internal::SdEvent::sd_event_get_exit_code>(
+            sdevent, get(), &code));
     return code;
 }
 
 bool Event::get_watchdog() const
 {
-    return SDEVENTPLUS_CHECK("sd_event_get_watchdog",
-                             sdevent->sd_event_get_watchdog(get()));
+    return SDEVENTPLUS_CHECK(
+        "sd_event_get_watchdog",
+        internal::call<&internal::SdEvent::sd_event_get_watchdog>(
+            sdevent, get()));
 }
 
 bool Event::set_watchdog(bool b) const
 {
-    return SDEVENTPLUS_CHECK("sd_event_set_watchdog",
-                             sdevent->sd_event_set_watchdog(get(), b));
+    return SDEVENTPLUS_CHECK(
+        "sd_event_set_watchdog",
+        internal::call<&internal::SdEvent::sd_event_set_watchdog>(
+            sdevent, get(), b));
+}
+
+int Event::runProfiled(MaybeTimeout timeout, LoopProfile& profile,
+                       bool& finished) const
+{
+    // Mirrors sd_event_run(), which hides the individual phases
+    using clock = std::chrono::steady_clock;
+    finished = false;
+    auto start = clock::now();
+    int r = prepare();
+    auto end = clock::now();
+    profile.prepare.record(end - start);
+    if (r == 0)
+    {
+        start = end;
+        r = wait(timeout);
+        end = clock::now();
+        profile.wait.record(end - start);
+    }
+    if (r == 0)
+    {
+        return 0;
+    }
+    start = end;
+    finished = dispatch() == 0;
+    profile.dispatch.record(clock::now() - start);
+    return 1;
+}
+
+size_t Event::runBatch(size_t max_events, MaybeTimeout budget,
+                       MaybeTimeout timeout, bool& finished) const
+{
+    using clock = std::chrono::steady_clock;
+    std::optional<clock::time_point> deadline;
+    if (budget)
+    {
+        deadline = clock::now() + *budget;
+    }
+    max_events = std::max<size_t>(max_events, 1);
+    finished = false;
+    size_t dispatched = 0;
+    while (dispatched < max_events)
+    {
+        // sd-event requires a prepare and wait for every dispatch, but only
+        // the first one may block
+        int r = prepare();
+        if (r == 0)
+        {
+            r = wait(dispatched == 0 ? timeout : Timeout(0));
+        }
+        if (r == 0)
+        {
+            break;
+        }
+        dispatched++;
+        if (dispatch() == 0)
+        {
+            finished = true;
+            break;
+        }
+        if (deadline && clock::now() >= *deadline)
+        {
+            break;
+        }
+    }
+    return dispatched;
+}
+
+int Event::loopBusyPoll(Timeout window, LoopProfile* profile) const
+{
+    using clock = std::chrono::steady_clock;
+    auto now = clock::now();
+    // Start out parked until the first event arrives
+    auto spinUntil = now;
+    bool finished = false;
+    while (!finished)
+    {
+        auto start = now;
+        int r = prepare();
+        now = clock::now();
+        if (profile != nullptr)
+        {
+            profile->prepare.record(now - start);
+        }
+        if (r == 0)
+        {
+            bool spin = now < spinUntil;
+            start = now;
+            r = wait(spin ? MaybeTimeout(Timeout(0)) : std::nullopt);
+            now = clock::now();
+            if (profile != nullptr)
+            {
+                profile->wait.record(now - start);
+                (spin ? profile->spins : profile->parks)++;
+            }
+        }
+        if (r == 0)
+        {
+            continue;
+        }
+        start = now;
+        finished = dispatch() == 0;
+        now = clock::now();
+        if (profile != nullptr)
+        {
+            profile->dispatch.record(now - start);
+        }
+        spinUntil = now + window;
+    }
+    return get_exit_code();
 }
 
-sd_event* Event::ref(sd_event* const& event, const internal::SdEvent*& sdevent,
-                     bool& owned)
+void Event::ref(const Event& other)
 {
-    owned = true;
-    return sdevent->sd_event_ref(event);
+    event = other.event == nullptr
+                ? nullptr
+                : internal::call<&internal::SdEvent::sd_event_ref>(
+                      other.sdevent, other.event);
+    owned = event != nullptr;
 }
 
-void Event::drop(sd_event*&& event, const internal::SdEvent*& sdevent,
-                 bool& owned)
+void Event::drop()
 {
     if (owned)
     {
-        sdevent->sd_event_unref(event);
+        internal::call<&internal::SdEvent::sd_event_unref>(sdevent, event);
     }
+    event = nullptr;
+    owned = false;
 }
 
 } // namespace sdeventplus
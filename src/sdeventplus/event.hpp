@@ -3,10 +3,13 @@
 #include <systemd/sd-event.h>
 
 #include <sdeventplus/internal/sdevent.hpp>
+#include <sdeventplus/profile.hpp>
 #include <sdeventplus/types.hpp>
-#include <stdplus/handle/copyable.hpp>
 
+#include <cstddef>
+#include <expected>
 #include <optional>
+#include <system_error>
 
 namespace sdeventplus
 {
@@ -56,6 +59,12 @@ class Event
      */
     Event(const Event& other, sdeventplus::internal::NoOwn);
 
+    Event(const Event& other);
+    Event& operator=(const Event& other);
+    Event(Event&& other) noexcept;
+    Event& operator=(Event&& other) noexcept;
+    ~Event();
+
     /** @brief Create a wrapped event around sd_event_new()
      *
      *  @param[in] sdevent - Optional underlying sd_event implementation
@@ -76,10 +85,17 @@ class Event
 
     /** @brief Get the underlying sd_event
      *
+     *  @throws std::bad_optional_access if the Event was moved from
      *  @return The sd_event
      */
     sd_event* get() const;
 
+    /** @brief Get the underlying sd_event without throwing
+     *
+     *  @return The sd_event, nullptr if the Event was moved from
+     */
+    sd_event* get_or_null() const noexcept;
+
     /** @brief Get the sd_event interface in use
      *
      *  @return The sd_event interface
@@ -119,6 +135,49 @@ class Event
      */
     int run(MaybeTimeout timeout) const;
 
+    /** @brief Runs a single iteration of the event loop without throwing
+     *
+     * @param[in] timeout - nullopt for no timeout or a finite timeout
+     * @return Positive value if an event was dispatched, 0 if a finite
+     *         timeout is reached, or the error reported by sd_event,
+     *         std::errc::bad_file_descriptor if the Event was moved from
+     */
+    std::expected<int, std::error_code>
+        try_run(MaybeTimeout timeout) const noexcept;
+
+    /** @brief Runs a single iteration of the event loop as separate
+     *         prepare, wait and dispatch steps, recording the time spent in
+     *         each of them
+     *
+     * @param[in] timeout - nullopt for no timeout or a finite timeout
+     * @param[in] profile - The profile accumulating the phase timings
+     * @throws SdEventError for underlying sd_event errors
+     * @return Positive value if an event was dispatched
+     *         Only returns 0 a finite timeout is reached
+     */
+    int run(MaybeTimeout timeout, LoopProfile& profile) const;
+
+    /** @brief Runs event loop iterations until up to max_events sources
+     *         have been dispatched. Only the first iteration waits for
+     *         events, the following ones dispatch already pending sources
+     *         in priority order and stop once none is left.
+     *         sd-event dispatches a single source per prepare and wait, so
+     *         this still makes one epoll_wait() call per dispatch, the same
+     *         as calling run() in a loop. It does not raise throughput, it
+     *         only bounds the number and time of dispatches per call.
+     *
+     * @param[in] max_events - The maximum number of dispatches, at least 1
+     * @param[in] budget     - nullopt for no limit or the time after which
+     *                         no further dispatch is started
+     * @param[in] timeout    - nullopt for no timeout or a finite timeout
+     *                         for the first wait
+     * @throws SdEventError for underlying sd_event errors
+     * @return The number of dispatched events
+     *         Only returns 0 a finite timeout is reached
+     */
+    size_t run_batch(size_t max_events, MaybeTimeout budget,
+                     MaybeTimeout timeout = std::nullopt) const;
+
     /** @brief Run the event loop to completion
      *
      * @throws SdEventError for underlying sd_event errors
@@ -126,6 +185,48 @@ class Event
      */
     int loop() const;
 
+    /** @brief Run the event loop to completion, recording the time spent in
+     *         each loop phase
+     *
+     * @param[in] profile - The profile accumulating the phase timings
+     * @throws SdEventError for underlying sd_event errors
+     * @return Exit status of the event loop from exit()
+     */
+    int loop(LoopProfile& profile) const;
+
+    /** @brief Run the event loop to completion, draining pending sources
+     *         in batches as run_batch() does before waiting again
+     *         Makes as many epoll_wait() calls as loop().
+     *
+     * @param[in] max_events - The maximum number of dispatches per batch
+     * @param[in] budget     - nullopt for no limit or the time budget of a
+     *                         batch
+     * @throws SdEventError for underlying sd_event errors
+     * @return Exit status of the event loop from exit()
+     */
+    int loop_batch(size_t max_events, MaybeTimeout budget) const;
+
+    /** @brief Run the event loop to completion, busy polling for new events
+     *         with zero timeout waits for a window after every dispatch.
+     *         Once the window passes without events the loop falls back
+     *         to blocking waits, so an idle loop does not burn CPU.
+     *
+     * @param[in] window - The time to keep spinning after a dispatch
+     * @throws SdEventError for underlying sd_event errors
+     * @return Exit status of the event loop from exit()
+     */
+    int loop_busy_poll(Timeout window) const;
+
+    /** @brief Run the event loop to completion as loop_busy_poll() does,
+     *         recording the loop phases and the spin and park counts
+     *
+     * @param[in] window  - The time to keep spinning after a dispatch
+     * @param[in] profile - The profile accumulating the phase timings
+     * @throws SdEventError for underlying sd_event errors
+     * @return Exit status of the event loop from exit()
+     */
+    int loop_busy_poll(Timeout window, LoopProfile& profile) const;
+
     /** @brief Sets the exit code for the loop and notifies
      *         the event loop it should terminate
      *
@@ -134,6 +235,15 @@ class Event
      */
     void exit(int code) const;
 
+    /** @brief Sets the exit code for the loop and notifies
+     *         the event loop it should terminate without throwing
+     *
+     * @param[in] code - The exit code
+     * @return Nothing, or the error reported by sd_event,
+     *         std::errc::bad_file_descriptor if the Event was moved from
+     */
+    std::expected<void, std::error_code> try_exit(int code) const noexcept;
+
     /** @brief Gets the exit code for the event loop
      *
      * @throws SdEventError for underlying sd_event errors
@@ -159,15 +269,45 @@ class Event
     bool set_watchdog(bool b) const;
 
   private:
-    static sd_event* ref(sd_event* const& event,
-                         const internal::SdEvent*& sdevent, bool& owned);
-    static void drop(sd_event*&& event, const internal::SdEvent*& sdevent,
-                     bool& owned);
+    /** @brief Runs one profiled iteration of the event loop
+     *
+     * @param[in] timeout   - nullopt for no timeout or a finite timeout
+     * @param[in] profile   - The profile accumulating the phase timings
+     * @param[out] finished - Set when the dispatch finished the loop
+     * @return Positive value if an event was dispatched, 0 otherwise
+     */
+    int runProfiled(MaybeTimeout timeout, LoopProfile& profile,
+                    bool& finished) const;
+
+    /** @brief Runs one batch of dispatches
+     *
+     * @param[in] max_events - The maximum number of dispatches
+     * @param[in] budget     - nullopt for no limit or the batch time budget
+     * @param[in] timeout    - nullopt for no timeout or a finite timeout
+     * @param[out] finished  - Set when a dispatch finished the loop
+     * @return The number of dispatched events
+     */
+    size_t runBatch(size_t max_events, MaybeTimeout budget,
+                    MaybeTimeout timeout, bool& finished) const;
+
+    /** @brief Runs the busy polling loop
+     *
+     * @param[in] window  - The time to keep spinning after a dispatch
+     * @param[in] profile - The optional profile to record into
+     * @return Exit status of the event loop from exit()
+     */
+    int loopBusyPoll(Timeout window, LoopProfile* profile) const;
+
+    /** @brief Takes a new reference on the event of other, if any */
+    void ref(const Event& other);
+    /** @brief Releases the held reference, if owned */
+    void drop();
 
+    /** @brief The wrapped sd_event, nullptr once moved from */
+    sd_event* event;
     const internal::SdEvent* sdevent;
-    stdplus::Copyable<sd_event*, const internal::SdEvent*,
-                      bool>::Handle<drop, ref>
-        event;
+    /** @brief Whether a reference on event is held */
+    bool owned;
 };
 
 } // namespace sdeventplus
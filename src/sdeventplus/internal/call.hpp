@@ -0,0 +1,45 @@
+#pragma once
+
+#include <sdeventplus/internal/sdevent.hpp>
+
+#include <functional>
+#include <utility>
+
+namespace sdeventplus
+{
+namespace internal
+{
+
+#ifdef SDEVENTPLUS_DIRECT_SDEVENT
+inline constexpr bool directSdEvent = true;
+#else
+inline constexpr bool directSdEvent = false;
+#endif
+
+/** @brief Invokes a method of the sd_event interface
+ *  @details When the library is built with the direct_sdevent option and the
+ *           interface is the default libsystemd implementation, the method
+ *           is called through the final SdEventImpl so the compiler can
+ *           inline it down to the libsystemd call. Other implementations,
+ *           like the test mock, are always called virtually.
+ *
+ *  @param[in] sdevent - The sd_event interface in use
+ *  @param[in] args... - The arguments passed to the method
+ *  @return The value returned by the method
+ */
+template <auto method, typename... Args>
+inline auto call(const SdEvent* sdevent, Args&&... args)
+{
+    if constexpr (directSdEvent)
+    {
+        if (sdevent == &sdevent_impl) [[likely]]
+        {
+            return std::invoke(method, sdevent_impl,
+                               std::forward<Args>(args)...);
+        }
+    }
+    return std::invoke(method, sdevent, std::forward<Args>(args)...);
+}
+
+} // namespace internal
+} // namespace sdeventplus
@@ -2,5 +2,41 @@
 #include <sdeventplus/exception.hpp>
 #include <stdplus/util/cexec.hpp>
 
+#include <expected>
+#include <system_error>
+
 #define SDEVENTPLUS_CHECK(msg, expr)                                           \
     CHECK_RET(expr, [&](int ret) { throw SdEventError(ret, (msg)); })
+
+namespace sdeventplus
+{
+namespace internal
+{
+
+/** @brief Converts the return value of an sd_event call into an expected
+ *         without throwing
+ *
+ *  @param[in] r - The value returned by sd_event, a negative errno on failure
+ *  @return The non-negative return value or the error code of the failure
+ */
+inline std::expected<int, std::error_code> expect(int r) noexcept
+{
+    if (r < 0)
+    {
+        return std::unexpected(std::error_code(-r, std::generic_category()));
+    }
+    return r;
+}
+
+/** @brief The error returned without throwing by calls on moved from handles
+ *
+ *  @return std::errc::bad_file_descriptor as an unexpected
+ */
+inline std::unexpected<std::error_code> movedFrom() noexcept
+{
+    return std::unexpected(
+        std::make_error_code(std::errc::bad_file_descriptor));
+}
+
+} // namespace internal
+} // namespace sdeventplus
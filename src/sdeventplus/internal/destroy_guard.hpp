@@ -0,0 +1,80 @@
+#pragma once
+
+namespace sdeventplus
+{
+namespace internal
+{
+
+/** @class DestroyGuard
+ *  @brief Lets a dispatch loop notice that one of the callbacks it ran
+ *         destroyed the object the loop belongs to
+ *  @details Utilities running user callbacks from their sources keep one as
+ *           a member. A Scope on the stack of the loop reports whether the
+ *           guard was destroyed since it was created, after which no member
+ *           of the owner may be touched anymore.
+ */
+class DestroyGuard
+{
+  public:
+    /** @class Scope
+     *  @brief Watches a DestroyGuard for the duration of a dispatch loop
+     *         Scopes may be nested when the loops are re-entered.
+     */
+    class Scope
+    {
+      public:
+        explicit Scope(DestroyGuard& guard) noexcept :
+            guard(&guard), outer(guard.destroyed)
+        {
+            guard.destroyed = &destroyed;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        ~Scope()
+        {
+            if (!destroyed)
+            {
+                guard->destroyed = outer;
+            }
+            else if (outer != nullptr)
+            {
+                *outer = true;
+            }
+        }
+
+        /** @brief Gets whether the guard was destroyed
+         *
+         *  @return 'true' if the owner of the guard no longer exists
+         */
+        bool gone() const noexcept
+        {
+            return destroyed;
+        }
+
+      private:
+        DestroyGuard* guard;
+        bool* outer;
+        bool destroyed = false;
+    };
+
+    DestroyGuard() = default;
+    DestroyGuard(const DestroyGuard&) = delete;
+    DestroyGuard& operator=(const DestroyGuard&) = delete;
+
+    ~DestroyGuard()
+    {
+        if (destroyed != nullptr)
+        {
+            *destroyed = true;
+        }
+    }
+
+  private:
+    /** @brief The flag of the innermost Scope, if any */
+    bool* destroyed = nullptr;
+};
+
+} // namespace internal
+} // namespace sdeventplus
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <utility>
+
+namespace sdeventplus
+{
+namespace internal
+{
+
+/** @brief Invokes a user callback run by a utility, logging any exception
+ *         instead of letting it escape into the sd-event dispatch
+ *
+ *  @param[in] name     - The utility named in the log message
+ *  @param[in] callback - The callback to invoke
+ *  @param[in] args...  - The arguments passed to the callback
+ */
+template <typename F, typename... Args>
+void loggedCall(const char* name, F& callback, Args&&... args) noexcept
+{
+    try
+    {
+        std::invoke(callback, std::forward<Args>(args)...);
+    }
+    catch (const std::exception& e)
+    {
+        fprintf(stderr, "sdeventplus: %s: %s\n", name, e.what());
+    }
+    catch (...)
+    {
+        fprintf(stderr, "sdeventplus: %s: Unknown error\n", name);
+    }
+}
+
+} // namespace internal
+} // namespace sdeventplus
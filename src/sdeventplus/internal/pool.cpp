@@ -0,0 +1,136 @@
+#include <sdeventplus/internal/pool.hpp>
+
+#include <array>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace sdeventplus
+{
+namespace internal
+{
+
+namespace
+{
+
+#ifndef SDEVENTPLUS_NO_SOURCE_POOL
+
+constexpr std::size_t granularity = alignof(std::max_align_t);
+constexpr std::size_t classes = 16;
+constexpr std::size_t maxCached = 1024;
+
+/** @class BlockCache
+ *  @brief Free lists of released blocks, one per size class
+ *         Every block is a separate operator new allocation, so a block
+ *         allocated on one thread may be freed on another and the cache
+ *         can release its blocks individually when the thread exits.
+ */
+class BlockCache
+{
+  public:
+    BlockCache() = default;
+    BlockCache(const BlockCache&) = delete;
+    BlockCache& operator=(const BlockCache&) = delete;
+
+    ~BlockCache()
+    {
+        for (auto& list : lists)
+        {
+            while (list.head != nullptr)
+            {
+                ::operator delete(std::exchange(list.head, list.head->next));
+            }
+        }
+        destroyed = true;
+    }
+
+    /** @brief Set once the cache of the thread is gone
+     *         Blocks may still be released by thread_local destructors
+     *         running afterwards, or by static destructors once the main
+     *         thread cached blocks. The flag is trivially destructible so it
+     *         stays readable then.
+     */
+    static thread_local bool destroyed;
+
+    void* allocate(std::size_t cls)
+    {
+        auto& list = lists[cls];
+        if (list.head == nullptr)
+        {
+            return ::operator new((cls + 1) * granularity);
+        }
+        list.count--;
+        return std::exchange(list.head, list.head->next);
+    }
+
+    void deallocate(void* ptr, std::size_t cls) noexcept
+    {
+        auto& list = lists[cls];
+        if (list.count >= maxCached)
+        {
+            ::operator delete(ptr);
+            return;
+        }
+        list.count++;
+        list.head = new (ptr) Block{list.head};
+    }
+
+  private:
+    struct Block
+    {
+        Block* next;
+    };
+
+    struct List
+    {
+        Block* head = nullptr;
+        std::size_t count = 0;
+    };
+
+    std::array<List, classes> lists;
+};
+
+thread_local bool BlockCache::destroyed = false;
+thread_local BlockCache cache;
+
+/** @brief Maps a size to its size class, sizes past the last class are
+ *         not pooled
+ */
+constexpr std::size_t sizeClass(std::size_t size)
+{
+    return size == 0 ? 0 : (size - 1) / granularity;
+}
+
+#endif
+
+} // namespace
+
+void* pool_allocate(std::size_t size)
+{
+#ifndef SDEVENTPLUS_NO_SOURCE_POOL
+    auto cls = sizeClass(size);
+    if (cls < classes && !BlockCache::destroyed)
+    {
+        return cache.allocate(cls);
+    }
+#endif
+    return ::operator new(size);
+}
+
+void pool_deallocate(void* ptr, std::size_t size) noexcept
+{
+#ifndef SDEVENTPLUS_NO_SOURCE_POOL
+    auto cls = sizeClass(size);
+    if (cls < classes && !BlockCache::destroyed)
+    {
+        cache.deallocate(ptr, cls);
+        return;
+    }
+#else
+    static_cast<void>(size);
+#endif
+    ::operator delete(ptr);
+}
+
+} // namespace internal
+} // namespace sdeventplus
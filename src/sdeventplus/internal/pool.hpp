@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+
+namespace sdeventplus
+{
+namespace internal
+{
+
+/** @brief Allocates a block for per-source state
+ *         Blocks come from a thread local cache of previously freed blocks
+ *         of the same size class, falling back to operator new when the
+ *         cache is empty or the size is too large to be pooled. Blocks
+ *         are only aligned for std::max_align_t.
+ *
+ *  @param[in] size - The number of bytes requested
+ *  @throws std::bad_alloc if no memory could be allocated
+ *  @return The allocated block
+ */
+void* pool_allocate(std::size_t size);
+
+/** @brief Returns a block from pool_allocate() to the cache of the
+ *         calling thread, or frees it if the cache is full or was already
+ *         destroyed by the exit of the thread
+ *
+ *  @param[in] ptr  - The block to release
+ *  @param[in] size - The size passed to pool_allocate()
+ */
+void pool_deallocate(void* ptr, std::size_t size) noexcept;
+
+} // namespace internal
+} // namespace sdeventplus
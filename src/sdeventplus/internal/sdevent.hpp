@@ -33,6 +33,16 @@ class SdEvent
     virtual int sd_event_add_child(
         sd_event* event, sd_event_source** source, pid_t, int options,
         sd_event_child_handler_t callback, void* userdata) const = 0;
+    virtual int sd_event_add_child_pidfd(
+        sd_event* event, sd_event_source** source, int pidfd, int options,
+        sd_event_child_handler_t callback, void* userdata) const = 0;
+    virtual int sd_event_add_inotify(
+        sd_event* event, sd_event_source** source, const char* path,
+        uint32_t mask, sd_event_inotify_handler_t callback,
+        void* userdata) const = 0;
+    virtual int sd_event_add_inotify_fd(
+        sd_event* event, sd_event_source** source, int fd, uint32_t mask,
+        sd_event_inotify_handler_t callback, void* userdata) const = 0;
     virtual int sd_event_add_defer(sd_event* event, sd_event_source** source,
                                    sd_event_handler_t callback,
                                    void* userdata) const = 0;
@@ -42,6 +52,10 @@ class SdEvent
     virtual int sd_event_add_exit(sd_event* event, sd_event_source** source,
                                   sd_event_handler_t callback,
                                   void* userdata) const = 0;
+    virtual int sd_event_add_memory_pressure(sd_event* event,
+                                             sd_event_source** source,
+                                             sd_event_handler_t callback,
+                                             void* userdata) const = 0;
 
     virtual int sd_event_prepare(sd_event* event) const = 0;
     virtual int sd_event_wait(sd_event* event, uint64_t usec) const = 0;
@@ -61,6 +75,8 @@ class SdEvent
         sd_event_source_ref(sd_event_source* source) const = 0;
     virtual sd_event_source*
         sd_event_source_unref(sd_event_source* source) const = 0;
+    virtual sd_event*
+        sd_event_source_get_event(sd_event_source* source) const = 0;
 
     virtual void*
         sd_event_source_get_userdata(sd_event_source* source) const = 0;
@@ -95,6 +111,8 @@ class SdEvent
                                          uint64_t* usec) const = 0;
     virtual int sd_event_source_set_time(sd_event_source* source,
                                          uint64_t usec) const = 0;
+    virtual int sd_event_source_set_time_relative(sd_event_source* source,
+                                                  uint64_t usec) const = 0;
     virtual int sd_event_source_get_time_accuracy(sd_event_source* source,
                                                   uint64_t* usec) const = 0;
     virtual int sd_event_source_set_time_accuracy(sd_event_source* source,
@@ -102,6 +120,21 @@ class SdEvent
     virtual int sd_event_source_get_signal(sd_event_source* source) const = 0;
     virtual int sd_event_source_get_child_pid(sd_event_source* source,
                                               pid_t* pid) const = 0;
+    virtual int
+        sd_event_source_get_child_pidfd(sd_event_source* source) const = 0;
+    virtual int
+        sd_event_source_get_child_pidfd_own(sd_event_source* source) const = 0;
+    virtual int sd_event_source_set_child_pidfd_own(sd_event_source* source,
+                                                    int own) const = 0;
+    virtual int sd_event_source_get_child_process_own(
+        sd_event_source* source) const = 0;
+    virtual int sd_event_source_set_child_process_own(sd_event_source* source,
+                                                      int own) const = 0;
+    virtual int sd_event_source_send_child_signal(sd_event_source* source,
+                                                  int sig, const siginfo_t* si,
+                                                  unsigned flags) const = 0;
+    virtual int sd_event_source_get_inotify_mask(sd_event_source* source,
+                                                 uint32_t* mask) const = 0;
     virtual int sd_event_source_set_destroy_callback(
         sd_event_source* source, sd_event_destroy_t callback) const = 0;
     virtual int sd_event_source_get_destroy_callback(
@@ -109,27 +142,65 @@ class SdEvent
     virtual int sd_event_source_set_floating(sd_event_source* source,
                                              int b) const = 0;
     virtual int sd_event_source_get_floating(sd_event_source* source) const = 0;
+    virtual int sd_event_source_set_ratelimit(sd_event_source* source,
+                                              uint64_t interval_usec,
+                                              unsigned burst) const = 0;
+    virtual int sd_event_source_get_ratelimit(sd_event_source* source,
+                                              uint64_t* interval_usec,
+                                              unsigned* burst) const = 0;
+    virtual int
+        sd_event_source_is_ratelimited(sd_event_source* source) const = 0;
+    virtual int sd_event_source_set_ratelimit_expire_callback(
+        sd_event_source* source, sd_event_handler_t callback) const = 0;
+    virtual int sd_event_source_set_memory_pressure_type(
+        sd_event_source* source, const char* type) const = 0;
+    virtual int sd_event_source_set_memory_pressure_period(
+        sd_event_source* source, uint64_t threshold_usec,
+        uint64_t window_usec) const = 0;
 };
 
 /** @class SdEventImpl
  *  @brief sd_event concrete implementation
  *  @details Uses libsystemd to handle all sd_event calls
  */
-class SdEventImpl : public SdEvent
+class SdEventImpl final : public SdEvent
 {
   public:
-    int sd_event_default(sd_event** event) const override;
-    int sd_event_new(sd_event** event) const override;
-    sd_event* sd_event_ref(sd_event* event) const override;
-    sd_event* sd_event_unref(sd_event* event) const override;
+    int sd_event_default(sd_event** event) const override
+    {
+        return ::sd_event_default(event);
+    }
+
+    int sd_event_new(sd_event** event) const override
+    {
+        return ::sd_event_new(event);
+    }
+
+    sd_event* sd_event_ref(sd_event* event) const override
+    {
+        return ::sd_event_ref(event);
+    }
+
+    sd_event* sd_event_unref(sd_event* event) const override
+    {
+        return ::sd_event_unref(event);
+    }
 
     int sd_event_add_io(sd_event* event, sd_event_source** source, int fd,
                         uint32_t events, sd_event_io_handler_t callback,
-                        void* userdata) const override;
+                        void* userdata) const override
+    {
+        return ::sd_event_add_io(event, source, fd, events, callback, userdata);
+    }
+
     int sd_event_add_time(sd_event* event, sd_event_source** source,
                           clockid_t clock, uint64_t usec, uint64_t accuracy,
                           sd_event_time_handler_t callback,
-                          void* userdata) const override;
+                          void* userdata) const override
+    {
+        return ::sd_event_add_time(event, source, clock, usec, accuracy,
+                                   callback, userdata);
+    }
 
     int sd_event_add_signal(sd_event* event, sd_event_source** source, int sig,
                             sd_event_signal_handler_t callback,
@@ -146,81 +217,352 @@ class SdEventImpl : public SdEvent
                                     userdata);
     }
 
+    int sd_event_add_child_pidfd(sd_event* event, sd_event_source** source,
+                                 int pidfd, int options,
+                                 sd_event_child_handler_t callback,
+                                 void* userdata) const override
+    {
+        return ::sd_event_add_child_pidfd(event, source, pidfd, options,
+                                          callback, userdata);
+    }
+
+    int sd_event_add_inotify(sd_event* event, sd_event_source** source,
+                             const char* path, uint32_t mask,
+                             sd_event_inotify_handler_t callback,
+                             void* userdata) const override
+    {
+        return ::sd_event_add_inotify(event, source, path, mask, callback,
+                                      userdata);
+    }
+
+    int sd_event_add_inotify_fd(sd_event* event, sd_event_source** source,
+                                int fd, uint32_t mask,
+                                sd_event_inotify_handler_t callback,
+                                void* userdata) const override
+    {
+        return ::sd_event_add_inotify_fd(event, source, fd, mask, callback,
+                                         userdata);
+    }
+
     int sd_event_add_defer(sd_event* event, sd_event_source** source,
                            sd_event_handler_t callback,
-                           void* userdata) const override;
+                           void* userdata) const override
+    {
+        return ::sd_event_add_defer(event, source, callback, userdata);
+    }
+
     int sd_event_add_post(sd_event* event, sd_event_source** source,
                           sd_event_handler_t callback,
-                          void* userdata) const override;
+                          void* userdata) const override
+    {
+        return ::sd_event_add_post(event, source, callback, userdata);
+    }
+
     int sd_event_add_exit(sd_event* event, sd_event_source** source,
                           sd_event_handler_t callback,
-                          void* userdata) const override;
+                          void* userdata) const override
+    {
+        return ::sd_event_add_exit(event, source, callback, userdata);
+    }
+
+    // Memory pressure sources need libsystemd 254, these are defined in
+    // sdevent.cpp and fail with -EOPNOTSUPP when built against older ones
+    int sd_event_add_memory_pressure(sd_event* event, sd_event_source** source,
+                                     sd_event_handler_t callback,
+                                     void* userdata) const override;
+
+    int sd_event_prepare(sd_event* event) const override
+    {
+        return ::sd_event_prepare(event);
+    }
+
+    int sd_event_wait(sd_event* event, uint64_t usec) const override
+    {
+        return ::sd_event_wait(event, usec);
+    }
+
+    int sd_event_dispatch(sd_event* event) const override
+    {
+        return ::sd_event_dispatch(event);
+    }
+
+    int sd_event_run(sd_event* event, uint64_t usec) const override
+    {
+        return ::sd_event_run(event, usec);
+    }
+
+    int sd_event_loop(sd_event* event) const override
+    {
+        return ::sd_event_loop(event);
+    }
 
-    int sd_event_prepare(sd_event* event) const override;
-    int sd_event_wait(sd_event* event, uint64_t usec) const override;
-    int sd_event_dispatch(sd_event* event) const override;
-    int sd_event_run(sd_event* event, uint64_t usec) const override;
-    int sd_event_loop(sd_event* event) const override;
-    int sd_event_exit(sd_event* event, int code) const override;
+    int sd_event_exit(sd_event* event, int code) const override
+    {
+        return ::sd_event_exit(event, code);
+    }
 
     int sd_event_now(sd_event* event, clockid_t clock,
-                     uint64_t* usec) const override;
+                     uint64_t* usec) const override
+    {
+        return ::sd_event_now(event, clock, usec);
+    }
 
-    int sd_event_get_exit_code(sd_event* event, int* code) const override;
-    int sd_event_get_watchdog(sd_event* event) const override;
-    int sd_event_set_watchdog(sd_event* event, int b) const override;
+    int sd_event_get_exit_code(sd_event* event, int* code) const override
+    {
+        return ::sd_event_get_exit_code(event, code);
+    }
+
+    int sd_event_get_watchdog(sd_event* event) const override
+    {
+        return ::sd_event_get_watchdog(event);
+    }
+
+    int sd_event_set_watchdog(sd_event* event, int b) const override
+    {
+        return ::sd_event_set_watchdog(event, b);
+    }
 
     sd_event_source*
-        sd_event_source_ref(sd_event_source* source) const override;
+        sd_event_source_ref(sd_event_source* source) const override
+    {
+        return ::sd_event_source_ref(source);
+    }
+
     sd_event_source*
-        sd_event_source_unref(sd_event_source* source) const override;
+        sd_event_source_unref(sd_event_source* source) const override
+    {
+        return ::sd_event_source_unref(source);
+    }
+
+    sd_event* sd_event_source_get_event(sd_event_source* source) const override
+    {
+        return ::sd_event_source_get_event(source);
+    }
+
+    void* sd_event_source_get_userdata(sd_event_source* source) const override
+    {
+        return ::sd_event_source_get_userdata(source);
+    }
 
-    void* sd_event_source_get_userdata(sd_event_source* source) const override;
     void* sd_event_source_set_userdata(sd_event_source* source,
-                                       void* userdata) const override;
+                                       void* userdata) const override
+    {
+        return ::sd_event_source_set_userdata(source, userdata);
+    }
 
     int sd_event_source_get_description(
-        sd_event_source* source, const char** description) const override;
+        sd_event_source* source, const char** description) const override
+    {
+        return ::sd_event_source_get_description(source, description);
+    }
+
     int sd_event_source_set_description(sd_event_source* source,
-                                        const char* description) const override;
+                                        const char* description) const override
+    {
+        return ::sd_event_source_set_description(source, description);
+    }
+
     int sd_event_source_set_prepare(sd_event_source* source,
-                                    sd_event_handler_t callback) const override;
-    int sd_event_source_get_pending(sd_event_source* source) const override;
+                                    sd_event_handler_t callback) const override
+    {
+        return ::sd_event_source_set_prepare(source, callback);
+    }
+
+    int sd_event_source_get_pending(sd_event_source* source) const override
+    {
+        return ::sd_event_source_get_pending(source);
+    }
+
     int sd_event_source_get_priority(sd_event_source* source,
-                                     int64_t* priority) const override;
+                                     int64_t* priority) const override
+    {
+        return ::sd_event_source_get_priority(source, priority);
+    }
+
     int sd_event_source_set_priority(sd_event_source* source,
-                                     int64_t priority) const override;
+                                     int64_t priority) const override
+    {
+        return ::sd_event_source_set_priority(source, priority);
+    }
+
     int sd_event_source_get_enabled(sd_event_source* source,
-                                    int* enabled) const override;
+                                    int* enabled) const override
+    {
+        return ::sd_event_source_get_enabled(source, enabled);
+    }
+
     int sd_event_source_set_enabled(sd_event_source* source,
-                                    int enabled) const override;
-    int sd_event_source_get_io_fd(sd_event_source* source) const override;
+                                    int enabled) const override
+    {
+        return ::sd_event_source_set_enabled(source, enabled);
+    }
+
+    int sd_event_source_get_io_fd(sd_event_source* source) const override
+    {
+        return ::sd_event_source_get_io_fd(source);
+    }
+
     int sd_event_source_set_io_fd(sd_event_source* source,
-                                  int fd) const override;
+                                  int fd) const override
+    {
+        return ::sd_event_source_set_io_fd(source, fd);
+    }
+
     int sd_event_source_get_io_events(sd_event_source* source,
-                                      uint32_t* events) const override;
+                                      uint32_t* events) const override
+    {
+        return ::sd_event_source_get_io_events(source, events);
+    }
+
     int sd_event_source_set_io_events(sd_event_source* source,
-                                      uint32_t events) const override;
+                                      uint32_t events) const override
+    {
+        return ::sd_event_source_set_io_events(source, events);
+    }
+
     int sd_event_source_get_io_revents(sd_event_source* source,
-                                       uint32_t* revents) const override;
+                                       uint32_t* revents) const override
+    {
+        return ::sd_event_source_get_io_revents(source, revents);
+    }
+
     int sd_event_source_get_time(sd_event_source* source,
-                                 uint64_t* usec) const override;
+                                 uint64_t* usec) const override
+    {
+        return ::sd_event_source_get_time(source, usec);
+    }
+
     int sd_event_source_set_time(sd_event_source* source,
-                                 uint64_t usec) const override;
+                                 uint64_t usec) const override
+    {
+        return ::sd_event_source_set_time(source, usec);
+    }
+
+    int sd_event_source_set_time_relative(sd_event_source* source,
+                                          uint64_t usec) const override
+    {
+        return ::sd_event_source_set_time_relative(source, usec);
+    }
+
     int sd_event_source_get_time_accuracy(sd_event_source* source,
-                                          uint64_t* usec) const override;
+                                          uint64_t* usec) const override
+    {
+        return ::sd_event_source_get_time_accuracy(source, usec);
+    }
+
     int sd_event_source_set_time_accuracy(sd_event_source* source,
-                                          uint64_t usec) const override;
-    int sd_event_source_get_signal(sd_event_source* source) const override;
+                                          uint64_t usec) const override
+    {
+        return ::sd_event_source_set_time_accuracy(source, usec);
+    }
+
+    int sd_event_source_get_signal(sd_event_source* source) const override
+    {
+        return ::sd_event_source_get_signal(source);
+    }
+
     int sd_event_source_get_child_pid(sd_event_source* source,
-                                      pid_t* pid) const override;
+                                      pid_t* pid) const override
+    {
+        return ::sd_event_source_get_child_pid(source, pid);
+    }
+
+    int sd_event_source_get_child_pidfd(sd_event_source* source) const override
+    {
+        return ::sd_event_source_get_child_pidfd(source);
+    }
+
+    int sd_event_source_get_child_pidfd_own(
+        sd_event_source* source) const override
+    {
+        return ::sd_event_source_get_child_pidfd_own(source);
+    }
+
+    int sd_event_source_set_child_pidfd_own(sd_event_source* source,
+                                            int own) const override
+    {
+        return ::sd_event_source_set_child_pidfd_own(source, own);
+    }
+
+    int sd_event_source_get_child_process_own(
+        sd_event_source* source) const override
+    {
+        return ::sd_event_source_get_child_process_own(source);
+    }
+
+    int sd_event_source_set_child_process_own(sd_event_source* source,
+                                              int own) const override
+    {
+        return ::sd_event_source_set_child_process_own(source, own);
+    }
+
+    int sd_event_source_send_child_signal(sd_event_source* source, int sig,
+                                          const siginfo_t* si,
+                                          unsigned flags) const override
+    {
+        return ::sd_event_source_send_child_signal(source, sig, si, flags);
+    }
+
+    int sd_event_source_get_inotify_mask(sd_event_source* source,
+                                         uint32_t* mask) const override
+    {
+        return ::sd_event_source_get_inotify_mask(source, mask);
+    }
+
     int sd_event_source_set_destroy_callback(
-        sd_event_source* source, sd_event_destroy_t callback) const override;
+        sd_event_source* source, sd_event_destroy_t callback) const override
+    {
+        return ::sd_event_source_set_destroy_callback(source, callback);
+    }
+
     int sd_event_source_get_destroy_callback(
-        sd_event_source* source, sd_event_destroy_t* callback) const override;
+        sd_event_source* source, sd_event_destroy_t* callback) const override
+    {
+        return ::sd_event_source_get_destroy_callback(source, callback);
+    }
+
     int sd_event_source_set_floating(sd_event_source* source,
-                                     int b) const override;
-    int sd_event_source_get_floating(sd_event_source* source) const override;
+                                     int b) const override
+    {
+        return ::sd_event_source_set_floating(source, b);
+    }
+
+    int sd_event_source_get_floating(sd_event_source* source) const override
+    {
+        return ::sd_event_source_get_floating(source);
+    }
+
+    int sd_event_source_set_ratelimit(sd_event_source* source,
+                                      uint64_t interval_usec,
+                                      unsigned burst) const override
+    {
+        return ::sd_event_source_set_ratelimit(source, interval_usec, burst);
+    }
+
+    int sd_event_source_get_ratelimit(sd_event_source* source,
+                                      uint64_t* interval_usec,
+                                      unsigned* burst) const override
+    {
+        return ::sd_event_source_get_ratelimit(source, interval_usec, burst);
+    }
+
+    int sd_event_source_is_ratelimited(sd_event_source* source) const override
+    {
+        return ::sd_event_source_is_ratelimited(source);
+    }
+
+    int sd_event_source_set_ratelimit_expire_callback(
+        sd_event_source* source, sd_event_handler_t callback) const override
+    {
+        return ::sd_event_source_set_ratelimit_expire_callback(source,
+                                                               callback);
+    }
+
+    int sd_event_source_set_memory_pressure_type(
+        sd_event_source* source, const char* type) const override;
+    int sd_event_source_set_memory_pressure_period(
+        sd_event_source* source, uint64_t threshold_usec,
+        uint64_t window_usec) const override;
 };
 
 /** @brief Default instantiation of sd_event
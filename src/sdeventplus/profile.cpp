@@ -0,0 +1,104 @@
+#include <sdeventplus/profile.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace sdeventplus
+{
+
+uint64_t Histogram::count() const
+{
+    return samples;
+}
+
+Histogram::Duration Histogram::total() const
+{
+    return Duration(sum);
+}
+
+Histogram::Duration Histogram::max() const
+{
+    return Duration(largest);
+}
+
+Histogram::Duration Histogram::mean() const
+{
+    return Duration(samples == 0 ? 0 : sum / samples);
+}
+
+Histogram::Duration Histogram::percentile(double quantile) const
+{
+    if (samples == 0)
+    {
+        return Duration(0);
+    }
+    quantile = std::clamp(quantile, 0.0, 1.0);
+    uint64_t rank = std::max<uint64_t>(1, std::ceil(quantile * samples));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets; ++i)
+    {
+        seen += counts[i];
+        if (seen >= rank)
+        {
+            return std::min(bucketMax(i), max());
+        }
+    }
+    return max();
+}
+
+uint64_t Histogram::bucketCount(size_t i) const
+{
+    return counts[i];
+}
+
+Histogram::Duration Histogram::bucketMax(size_t i)
+{
+    if (i < subBuckets)
+    {
+        return Duration(i);
+    }
+    size_t shift = i / subBuckets - 1;
+    uint64_t low = (subBuckets + i % subBuckets) << shift;
+    return Duration(low + ((uint64_t{1} << shift) - 1));
+}
+
+void Histogram::reset()
+{
+    *this = Histogram();
+}
+
+uint64_t LoopProfile::iterations() const
+{
+    return prepare.count();
+}
+
+double LoopProfile::utilization() const
+{
+    auto busy = prepare.total() + dispatch.total();
+    auto all = busy + wait.total();
+    if (all.count() == 0)
+    {
+        return 0;
+    }
+    return static_cast<double>(busy.count()) / all.count();
+}
+
+double LoopProfile::spinRatio() const
+{
+    if (spins + parks == 0)
+    {
+        return 0;
+    }
+    return static_cast<double>(spins) / (spins + parks);
+}
+
+void LoopProfile::reset()
+{
+    prepare.reset();
+    wait.reset();
+    dispatch.reset();
+    spins = 0;
+    parks = 0;
+}
+
+} // namespace sdeventplus
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace sdeventplus
+{
+
+/** @class Histogram
+ *  @brief A fixed size log-linear histogram of durations
+ *         Every power of two nanoseconds is split into subBuckets linear
+ *         buckets, bounding the error of any reported value to 1/subBuckets
+ *         while recording stays a handful of integer operations.
+ */
+class Histogram
+{
+  public:
+    using Duration = std::chrono::nanoseconds;
+
+    /** @brief The number of linear buckets per power of two */
+    static constexpr size_t subBuckets = 8;
+    /** @brief The total number of buckets covering any 64 bit duration */
+    static constexpr size_t buckets = (64 - 3 + 1) * subBuckets;
+
+    /** @brief Adds a single duration to the histogram
+     *
+     *  @param[in] d - The duration, negative values are counted as 0
+     */
+    inline void record(Duration d)
+    {
+        uint64_t ns = d.count() > 0 ? d.count() : 0;
+        counts[bucket(ns)]++;
+        samples++;
+        sum += ns;
+        if (ns > largest)
+        {
+            largest = ns;
+        }
+    }
+
+    /** @brief Gets the number of recorded durations */
+    uint64_t count() const;
+
+    /** @brief Gets the sum of all recorded durations */
+    Duration total() const;
+
+    /** @brief Gets the largest recorded duration */
+    Duration max() const;
+
+    /** @brief Gets the average recorded duration, 0 if empty */
+    Duration mean() const;
+
+    /** @brief Gets an upper bound for the given quantile of the recorded
+     *         durations. The bound is within one bucket of the real value
+     *         and never above the largest recorded duration.
+     *
+     *  @param[in] quantile - The quantile in the range [0, 1]
+     *  @return The duration, 0 if the histogram is empty
+     */
+    Duration percentile(double quantile) const;
+
+    /** @brief Gets the number of durations recorded in a bucket
+     *
+     *  @param[in] i - The bucket index, less than buckets
+     *  @return The number of durations
+     */
+    uint64_t bucketCount(size_t i) const;
+
+    /** @brief Gets the largest duration counted by a bucket
+     *
+     *  @param[in] i - The bucket index, less than buckets
+     *  @return The duration
+     */
+    static Duration bucketMax(size_t i);
+
+    /** @brief Discards all recorded durations */
+    void reset();
+
+  private:
+    std::array<uint64_t, buckets> counts = {};
+    uint64_t samples = 0;
+    uint64_t sum = 0;
+    uint64_t largest = 0;
+
+    static constexpr size_t subBits = std::countr_zero(subBuckets);
+
+    static constexpr size_t bucket(uint64_t ns)
+    {
+        if (ns < subBuckets)
+        {
+            return ns;
+        }
+        size_t shift = std::bit_width(ns) - 1 - subBits;
+        return (shift + 1) * subBuckets + ((ns >> shift) & (subBuckets - 1));
+    }
+};
+
+/** @class LoopProfile
+ *  @brief Time spent in each phase of the event loop iterations run with
+ *         the Event::run(), Event::loop() and Event::loop_busy_poll()
+ *         overloads taking a profile
+ */
+class LoopProfile
+{
+  public:
+    /** @brief Time spent preparing sources and arming timers */
+    Histogram prepare;
+    /** @brief Time spent idle waiting for events */
+    Histogram wait;
+    /** @brief Time spent dispatching the ready source */
+    Histogram dispatch;
+
+    /** @brief Zero timeout waits made while busy polling */
+    uint64_t spins = 0;
+    /** @brief Blocking waits made once busy polling gave up */
+    uint64_t parks = 0;
+
+    /** @brief Gets the number of profiled loop iterations */
+    uint64_t iterations() const;
+
+    /** @brief Gets the fraction of the profiled time the loop was busy
+     *         preparing or dispatching rather than waiting for events
+     *
+     *  @return The utilization in the range [0, 1], 0 if nothing was profiled
+     */
+    double utilization() const;
+
+    /** @brief Gets the fraction of busy polling waits which spun instead of
+     *         parking the thread
+     *
+     *  @return The ratio in the range [0, 1], 0 if no wait was counted
+     */
+    double spinRatio() const;
+
+    /** @brief Discards all recorded phases */
+    void reset();
+};
+
+} // namespace sdeventplus
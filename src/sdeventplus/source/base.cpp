@@ -1,9 +1,21 @@
+#include <sdeventplus/internal/call.hpp>
 #include <sdeventplus/internal/cexec.hpp>
+#include <sdeventplus/internal/pool.hpp>
 #include <sdeventplus/internal/sdevent.hpp>
 #include <sdeventplus/source/base.hpp>
 #include <sdeventplus/types.hpp>
 
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <chrono>
+#include <cstdio>
+#include <expected>
 #include <functional>
+#include <memory>
+#include <new>
+#include <optional>
+#include <system_error>
 #include <utility>
 
 namespace sdeventplus
@@ -13,7 +25,16 @@ namespace source
 
 sd_event_source* Base::get() const
 {
-    return source.value();
+    if (source == nullptr)
+    {
+        throw std::bad_optional_access();
+    }
+    return source;
+}
+
+sd_event_source* Base::get_or_null() const noexcept
+{
+    return source;
 }
 
 const Event& Base::get_event() const
@@ -24,31 +45,40 @@ const Event& Base::get_event() const
 const char* Base::get_description() const
 {
     const char* description;
-    SDEVENTPLUS_CHECK("sd_event_source_get_description",
-                      event.getSdEvent()->sd_event_source_get_description(
-                          get(), &description));
+    SDEVENTPLUS_CHECK(
+        "sd_event_source_get_description",
+        internal::call<&internal::SdEvent::sd_event_source_get_description>(
+            event.getSdEvent(), get(), &description));
     return description;
 }
 
 void Base::set_description(const char* description) const
 {
-    SDEVENTPLUS_CHECK("sd_event_source_set_description",
-                      event.getSdEvent()->sd_event_source_set_description(
-                          get(), description));
+    SDEVENTPLUS_CHECK(
+        "sd_event_source_set_description",
+        internal::call<&internal::SdEvent::sd_event_source_set_description>(
+            event.getSdEvent(), get(), description));
 }
 
 void Base::set_prepare(Callback&& callback)
 {
     try
     {
-        SDEVENTPLUS_CHECK("sd_event_source_set_prepare",
-                          event.getSdEvent()->sd_event_source_set_prepare(
-                              get(), callback ? prepareCallback : nullptr));
-        get_userdata().prepare = std::move(callback);
+        SDEVENTPLUS_CHECK(
+            "sd_event_source_set_prepare",
+            internal::call<&internal::SdEvent::sd_event_source_set_prepare>(
+                event.getSdEvent(), get(),
+                callback ? prepareCallback : nullptr));
+        get_prepare() = std::move(callback);
     }
     catch (...)
     {
-        get_userdata().prepare = nullptr;
+        // Sources which never had extras have no callback to drop
+        auto& data = get_userdata();
+        if (data.extra)
+        {
+            data.extra->prepare = nullptr;
+        }
         throw;
     }
 }
@@ -57,7 +87,8 @@ bool Base::get_pending() const
 {
     return SDEVENTPLUS_CHECK(
         "sd_event_source_get_pending",
-        event.getSdEvent()->sd_event_source_get_pending(get()));
+        internal::call<&internal::SdEvent::sd_event_source_get_pending>(
+            event.getSdEvent(), get()));
 }
 
 int64_t Base::get_priority() const
@@ -65,7 +96,8 @@ int64_t Base::get_priority() const
     int64_t priority;
     SDEVENTPLUS_CHECK(
         "sd_event_source_get_priority",
-        event.getSdEvent()->sd_event_source_get_priority(get(), &priority));
+        internal::call<&internal::SdEvent::sd_event_source_get_priority>(
+            event.getSdEvent(), get(), &priority));
     return priority;
 }
 
@@ -73,7 +105,21 @@ void Base::set_priority(int64_t priority) const
 {
     SDEVENTPLUS_CHECK(
         "sd_event_source_set_priority",
-        event.getSdEvent()->sd_event_source_set_priority(get(), priority));
+        internal::call<&internal::SdEvent::sd_event_source_set_priority>(
+            event.getSdEvent(), get(), priority));
+}
+
+std::expected<void, std::error_code>
+    Base::try_set_priority(int64_t priority) const noexcept
+{
+    if (source == nullptr)
+    {
+        return internal::movedFrom();
+    }
+    return internal::expect(
+               internal::call<&internal::SdEvent::sd_event_source_set_priority>(
+                   event.getSdEvent(), source, priority))
+        .transform([](int) {});
 }
 
 Enabled Base::get_enabled() const
@@ -81,92 +127,344 @@ Enabled Base::get_enabled() const
     int enabled;
     SDEVENTPLUS_CHECK(
         "sd_event_source_get_enabled",
-        event.getSdEvent()->sd_event_source_get_enabled(get(), &enabled));
+        internal::call<&internal::SdEvent::sd_event_source_get_enabled>(
+            event.getSdEvent(), get(), &enabled));
     return static_cast<Enabled>(enabled);
 }
 
 void Base::set_enabled(Enabled enabled) const
 {
-    SDEVENTPLUS_CHECK("sd_event_source_set_enabled",
-                      event.getSdEvent()->sd_event_source_set_enabled(
-                          get(), static_cast<int>(enabled)));
+    SDEVENTPLUS_CHECK(
+        "sd_event_source_set_enabled",
+        internal::call<&internal::SdEvent::sd_event_source_set_enabled>(
+            event.getSdEvent(), get(), static_cast<int>(enabled)));
+}
+
+std::expected<Enabled, std::error_code> Base::try_get_enabled() const noexcept
+{
+    if (source == nullptr)
+    {
+        return internal::movedFrom();
+    }
+    int enabled;
+    return internal::expect(
+               internal::call<&internal::SdEvent::sd_event_source_get_enabled>(
+                   event.getSdEvent(), source, &enabled))
+        .transform([&](int) { return static_cast<Enabled>(enabled); });
+}
+
+std::expected<void, std::error_code>
+    Base::try_set_enabled(Enabled enabled) const noexcept
+{
+    if (source == nullptr)
+    {
+        return internal::movedFrom();
+    }
+    return internal::expect(
+               internal::call<&internal::SdEvent::sd_event_source_set_enabled>(
+                   event.getSdEvent(), source, static_cast<int>(enabled)))
+        .transform([](int) {});
 }
 
 bool Base::get_floating() const
 {
     return SDEVENTPLUS_CHECK(
         "sd_event_source_get_floating",
-        event.getSdEvent()->sd_event_source_get_floating(get()));
+        internal::call<&internal::SdEvent::sd_event_source_get_floating>(
+            event.getSdEvent(), get()));
 }
 
 void Base::set_floating(bool b) const
 {
-    SDEVENTPLUS_CHECK("sd_event_source_set_floating",
-                      event.getSdEvent()->sd_event_source_set_floating(
-                          get(), static_cast<int>(b)));
+    SDEVENTPLUS_CHECK(
+        "sd_event_source_set_floating",
+        internal::call<&internal::SdEvent::sd_event_source_set_floating>(
+            event.getSdEvent(), get(), static_cast<int>(b)));
+}
+
+void Base::set_stats(bool enabled) const
+{
+    auto& data = get_userdata();
+    if (!enabled)
+    {
+        if (data.extra)
+        {
+            data.extra->stats.reset();
+        }
+    }
+    else if (!hasStats(data))
+    {
+        data.get_extra().stats.emplace();
+    }
+}
+
+std::optional<Base::Stats> Base::get_stats() const
+{
+    const auto& data = get_userdata();
+    if (!hasStats(data))
+    {
+        return std::nullopt;
+    }
+    Stats ret = *data.extra->stats;
+    // A source without a description is not an error here
+    const char* description;
+    if (internal::call<&internal::SdEvent::sd_event_source_get_description>(
+            event.getSdEvent(), get(), &description) >= 0 &&
+        description != nullptr)
+    {
+        ret.description = description;
+    }
+    return ret;
+}
+
+void Base::set_ratelimit(std::optional<RateLimit> limit) const
+{
+    if (limit)
+    {
+        // The expiry handler counts the throttling periods
+        get_userdata().get_extra();
+        SDEVENTPLUS_CHECK(
+            "sd_event_source_set_ratelimit_expire_callback",
+            internal::call<&internal::SdEvent::
+                               sd_event_source_set_ratelimit_expire_callback>(
+                event.getSdEvent(), get(), ratelimitExpireCallback));
+    }
+    SDEVENTPLUS_CHECK(
+        "sd_event_source_set_ratelimit",
+        internal::call<&internal::SdEvent::sd_event_source_set_ratelimit>(
+            event.getSdEvent(), get(), limit ? limit->interval.count() : 0,
+            limit ? limit->burst : 0));
+}
+
+std::optional<Base::RateLimit> Base::get_ratelimit() const
+{
+    uint64_t interval;
+    unsigned burst;
+    int r = internal::call<&internal::SdEvent::sd_event_source_get_ratelimit>(
+        event.getSdEvent(), get(), &interval, &burst);
+    // sd-event reports a source without a rate limit as ENOEXEC
+    if (r == -ENOEXEC)
+    {
+        return std::nullopt;
+    }
+    SDEVENTPLUS_CHECK("sd_event_source_get_ratelimit", r);
+    return RateLimit{SdEventDuration(interval), burst};
+}
+
+bool Base::is_ratelimited() const
+{
+    return SDEVENTPLUS_CHECK(
+        "sd_event_source_is_ratelimited",
+        internal::call<&internal::SdEvent::sd_event_source_is_ratelimited>(
+            event.getSdEvent(), get()));
+}
+
+void Base::set_ratelimit_expire(Callback&& callback)
+{
+    get_ratelimit_expire() = std::move(callback);
+}
+
+uint64_t Base::get_throttled() const
+{
+    const auto& data = get_userdata();
+    return data.extra ? data.extra->throttled : 0;
+}
+
+Base::Base(Base&& other) noexcept :
+    event(std::move(other.event)),
+    source(std::exchange(other.source, nullptr)),
+    owned(std::exchange(other.owned, false))
+{}
+
+Base& Base::operator=(Base&& other) noexcept
+{
+    if (this != &other)
+    {
+        drop();
+        event = std::move(other.event);
+        source = std::exchange(other.source, nullptr);
+        owned = std::exchange(other.owned, false);
+    }
+    return *this;
+}
+
+Base::Base(const Base& other) : event(other.event)
+{
+    ref(other);
+}
+
+Base& Base::operator=(const Base& other)
+{
+    if (this != &other)
+    {
+        drop();
+        event = other.event;
+        ref(other);
+    }
+    return *this;
+}
+
+Base::~Base()
+{
+    drop();
 }
 
 Base::Base(const Event& event, sd_event_source* source, std::false_type) :
-    event(event), source(std::move(source), event.getSdEvent(), true)
+    event(event), source(source), owned(true)
 {}
 
 Base::Base(const Base& other, sdeventplus::internal::NoOwn) :
     event(other.get_event(), sdeventplus::internal::NoOwn()),
-    source(other.get(), event.getSdEvent(), false)
+    source(other.get()), owned(false)
 {}
 
 void Base::set_userdata(std::unique_ptr<detail::BaseData> data) const
 {
-    SDEVENTPLUS_CHECK("sd_event_source_set_destroy_callback",
-                      event.getSdEvent()->sd_event_source_set_destroy_callback(
-                          get(), &Base::destroy_userdata));
-    event.getSdEvent()->sd_event_source_set_userdata(get(), data.release());
+    SDEVENTPLUS_CHECK(
+        "sd_event_source_set_destroy_callback",
+        internal::call<&internal::SdEvent::sd_event_source_set_destroy_callback>(
+            event.getSdEvent(), get(), &Base::destroy_userdata));
+    internal::call<&internal::SdEvent::sd_event_source_set_userdata>(
+        event.getSdEvent(), get(), data.release());
 }
 
 detail::BaseData& Base::get_userdata() const
 {
     return *reinterpret_cast<detail::BaseData*>(
-        event.getSdEvent()->sd_event_source_get_userdata(get()));
+        internal::call<&internal::SdEvent::sd_event_source_get_userdata>(
+            event.getSdEvent(), get()));
 }
 
 Base::Callback& Base::get_prepare()
 {
-    return get_userdata().prepare;
+    return get_userdata().get_extra().prepare;
+}
+
+Base::Callback& Base::get_ratelimit_expire()
+{
+    return get_userdata().get_extra().ratelimitExpire;
 }
 
-sd_event_source* Base::ref(sd_event_source* const& source,
-                           const internal::SdEvent*& sdevent, bool& owned)
+void Base::ref(const Base& other)
 {
-    owned = true;
-    return sdevent->sd_event_source_ref(source);
+    source = other.source == nullptr
+                 ? nullptr
+                 : internal::call<&internal::SdEvent::sd_event_source_ref>(
+                       other.event.getSdEvent(), other.source);
+    owned = source != nullptr;
 }
 
-void Base::drop(sd_event_source*&& source, const internal::SdEvent*& sdevent,
-                bool& owned)
+void Base::drop()
 {
     if (owned)
     {
-        sdevent->sd_event_source_unref(source);
+        internal::call<&internal::SdEvent::sd_event_source_unref>(
+            event.getSdEvent(), source);
     }
+    source = nullptr;
+    owned = false;
 }
 
 void Base::destroy_userdata(void* userdata)
 {
-    delete static_cast<Base*>(userdata);
+    delete static_cast<detail::BaseData*>(userdata);
 }
 
-int Base::prepareCallback(sd_event_source* source, void* userdata)
+void Base::recordDispatch(detail::BaseData& data,
+                          std::chrono::steady_clock::time_point start,
+                          bool success)
 {
-    return sourceCallback<Callback, Base, &Base::get_prepare>(
-        "prepareCallback", source, userdata);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    if (!hasStats(data))
+    {
+        return;
+    }
+    auto& stats = *data.extra->stats;
+    stats.dispatches++;
+    if (!success)
+    {
+        stats.exceptions++;
+    }
+    stats.total += elapsed;
+    stats.max = std::max<std::chrono::nanoseconds>(stats.max, elapsed);
+}
+
+int Base::prepareCallback(sd_event_source*, void* userdata)
+{
+    if (userdata == nullptr)
+    {
+        fprintf(stderr, "sdeventplus: prepareCallback: Missing userdata\n");
+        return -EINVAL;
+    }
+    auto& data = *static_cast<detail::BaseData*>(userdata);
+    // The prepare callback is only registered once the extras exist
+    invokeCallback("prepareCallback", data.extra->prepare, data.get_source());
+    return 0;
+}
+
+int Base::ratelimitExpireCallback(sd_event_source*, void* userdata)
+{
+    if (userdata == nullptr)
+    {
+        fprintf(stderr,
+                "sdeventplus: ratelimitExpireCallback: Missing userdata\n");
+        return -EINVAL;
+    }
+    auto& data = *static_cast<detail::BaseData*>(userdata);
+    // The expire callback is only registered once the extras exist
+    data.extra->throttled++;
+    if (data.extra->ratelimitExpire)
+    {
+        invokeCallback("ratelimitExpireCallback", data.extra->ratelimitExpire,
+                       data.get_source());
+    }
+    return 0;
 }
 
 namespace detail
 {
 
-BaseData::BaseData(const Base& base) :
-    Base(base, sdeventplus::internal::NoOwn())
-{}
+void* BaseData::operator new(std::size_t size)
+{
+    return internal::pool_allocate(size);
+}
+
+void BaseData::operator delete(void* ptr, std::size_t size) noexcept
+{
+    internal::pool_deallocate(ptr, size);
+}
+
+void* BaseData::operator new(std::size_t size, std::align_val_t align)
+{
+    return ::operator new(size, align);
+}
+
+void BaseData::operator delete(void* ptr, std::size_t size,
+                               std::align_val_t align) noexcept
+{
+    ::operator delete(ptr, size, align);
+}
+
+void* BaseData::Extra::operator new(std::size_t size)
+{
+    // Pool blocks are only aligned for std::max_align_t
+    static_assert(alignof(Extra) <= alignof(std::max_align_t));
+    return internal::pool_allocate(size);
+}
+
+void BaseData::Extra::operator delete(void* ptr, std::size_t size) noexcept
+{
+    internal::pool_deallocate(ptr, size);
+}
+
+BaseData::Extra& BaseData::get_extra()
+{
+    if (!extra)
+    {
+        extra = std::make_unique<Extra>();
+    }
+    return *extra;
+}
 
 } // namespace detail
 
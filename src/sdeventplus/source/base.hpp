@@ -5,13 +5,19 @@
 #include <function2/function2.hpp>
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/types.hpp>
-#include <stdplus/handle/copyable.hpp>
 
 #include <cerrno>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
+#include <expected>
 #include <functional>
 #include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <system_error>
 #include <type_traits>
 #include <utility>
 
@@ -45,18 +51,42 @@ class Base
   public:
     using Callback = fu2::unique_function<void(Base& source)>;
 
-    Base(Base&& other) = default;
-    Base& operator=(Base&& other) = default;
-    Base(const Base& other) = default;
-    Base& operator=(const Base& other) = default;
-    virtual ~Base() = default;
+    /** @class Stats
+     *  @brief Dispatch statistics collected for a source
+     */
+    struct Stats
+    {
+        /** @brief The description of the source, empty if it has none */
+        std::string description;
+        /** @brief The number of times the callback was dispatched */
+        uint64_t dispatches = 0;
+        /** @brief The number of dispatches which threw an exception */
+        uint64_t exceptions = 0;
+        /** @brief The total wall time spent in the callback */
+        std::chrono::nanoseconds total = {};
+        /** @brief The longest wall time spent in a single dispatch */
+        std::chrono::nanoseconds max = {};
+    };
+
+    Base(Base&& other) noexcept;
+    Base& operator=(Base&& other) noexcept;
+    Base(const Base& other);
+    Base& operator=(const Base& other);
+    virtual ~Base();
 
     /** @brief Gets the underlying sd_event_source
      *
+     *  @throws std::bad_optional_access if the source was moved from
      *  @return The sd_event_source
      */
     sd_event_source* get() const;
 
+    /** @brief Gets the underlying sd_event_source without throwing
+     *
+     *  @return The sd_event_source, nullptr if the source was moved from
+     */
+    sd_event_source* get_or_null() const noexcept;
+
     /** @brief Gets the associated Event object
      *
      *  @return The Event
@@ -110,6 +140,15 @@ class Base
      */
     void set_priority(int64_t priority) const;
 
+    /** @brief Sets the priority of the source without throwing
+     *
+     *  @param[in] priority - A 64 bit integer representing the priority
+     *  @return Nothing, or the error reported by sd_event,
+     *          std::errc::bad_file_descriptor if the source was moved from
+     */
+    std::expected<void, std::error_code>
+        try_set_priority(int64_t priority) const noexcept;
+
     /** @brief Determines the enablement value of the source
      *
      *  @throws SdEventError for underlying sd_event errors
@@ -124,6 +163,23 @@ class Base
      */
     void set_enabled(Enabled enabled) const;
 
+    /** @brief Determines the enablement value of the source without throwing
+     *
+     *  @return The enabled status of the source, or the error reported by
+     *          sd_event, std::errc::bad_file_descriptor if the source was
+     *          moved from
+     */
+    std::expected<Enabled, std::error_code> try_get_enabled() const noexcept;
+
+    /** @brief Sets the enablement value of the source without throwing
+     *
+     *  @param[in] enabled - The new state of the source
+     *  @return Nothing, or the error reported by sd_event,
+     *          std::errc::bad_file_descriptor if the source was moved from
+     */
+    std::expected<void, std::error_code>
+        try_set_enabled(Enabled enabled) const noexcept;
+
     /** @brief Determines the floating nature of the source
      *
      *  @throws SdEventError for underlying sd_event errors
@@ -140,6 +196,74 @@ class Base
      */
     void set_floating(bool b) const;
 
+    /** @brief Enables or disables the collection of dispatch statistics
+     *         for the source. Collection is off by default as it adds
+     *         clock reads to every dispatch. Enabling an already enabled
+     *         source keeps the current counts, disabling discards them.
+     *
+     *  @param[in] enabled - Whether or not statistics should be collected
+     */
+    void set_stats(bool enabled) const;
+
+    /** @brief Gets the dispatch statistics of the source, keyed by its
+     *         current description
+     *
+     *  @return The statistics, or std::nullopt if collection is disabled
+     */
+    std::optional<Stats> get_stats() const;
+
+    /** @class RateLimit
+     *  @brief The dispatch rate limit of a source
+     *         The source is dispatched at most burst times per interval.
+     */
+    struct RateLimit
+    {
+        SdEventDuration interval;
+        unsigned burst;
+    };
+
+    /** @brief Limits how often the source can be dispatched
+     *         Once the limit is hit, sd-event takes the source offline
+     *         until the interval ends. This keeps a source which is always
+     *         ready, like a misbehaving IO peer, from starving the others.
+     *
+     *  @param[in] limit - The rate limit, std::nullopt to remove it
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    void set_ratelimit(std::optional<RateLimit> limit) const;
+
+    /** @brief Gets the dispatch rate limit of the source
+     *
+     *  @throws SdEventError for underlying sd_event errors
+     *  @return The rate limit, std::nullopt if the source has none
+     */
+    std::optional<RateLimit> get_ratelimit() const;
+
+    /** @brief Determines if the source is currently throttled by its rate
+     *         limit
+     *
+     *  @throws SdEventError for underlying sd_event errors
+     *  @return 'true' if the source is offline until its interval ends
+     *          'false' otherwise
+     */
+    bool is_ratelimited() const;
+
+    /** @brief Sets the callback run each time the source comes back online
+     *         after having been throttled by its rate limit
+     *
+     *  @param[in] callback - Function run when the throttling ends
+     */
+    void set_ratelimit_expire(Callback&& callback);
+
+    /** @brief Gets the number of rate limit periods that ended
+     *         Counted when the source comes back online, so a source which
+     *         is currently throttled is not included yet. Use
+     *         is_ratelimited() to check for an ongoing throttle.
+     *
+     *  @return The number of throttling periods which ended
+     */
+    uint64_t get_throttled() const;
+
   protected:
     Event event;
 
@@ -187,6 +311,14 @@ class Base
      */
     Callback& get_prepare();
 
+    /** @brief Returns a reference to the rate limit expire callback
+     *         executed for this source
+     *
+     *  @return A reference to the callback, this should be checked to make sure
+     *          the callback is valid as there is no guarantee
+     */
+    Callback& get_ratelimit_expire();
+
     /** @brief A helper for subclasses to trivially wrap a c++ style callback
      *         to be called from the sd-event c library
      *
@@ -208,9 +340,36 @@ class Base
         Data& data =
             static_cast<Data&>(*reinterpret_cast<detail::BaseData*>(userdata));
         Callback& callback = std::invoke(getter, data);
+        if (hasStats(data)) [[unlikely]]
+        {
+            auto start = std::chrono::steady_clock::now();
+            bool success = invokeCallback(name, callback, data,
+                                          std::forward<Args>(args)...);
+            recordDispatch(data, start, success);
+            return 0;
+        }
+        invokeCallback(name, callback, data, std::forward<Args>(args)...);
+        return 0;
+    }
+
+  private:
+    /** @brief Runs the callback, reporting any exception it throws
+     *
+     *  @param[in] name     - The name of the callback for use in error messages
+     *  @param[in] callback - The callback to run
+     *  @param[in] data     - The source passed to the callback
+     *  @param[in] args...  - Extra arguments to pass to the callaback
+     *  @return 'true' if the callback returned normally
+     *          'false' if it threw an exception
+     */
+    template <typename Callback, class Data, typename... Args>
+    static bool invokeCallback(const char* name, Callback& callback, Data& data,
+                               Args&&... args)
+    {
         try
         {
             std::invoke(callback, data, std::forward<Args>(args)...);
+            return true;
         }
         catch (const std::exception& e)
         {
@@ -220,18 +379,36 @@ class Base
         {
             fprintf(stderr, "sdeventplus: %s: Unknown error\n", name);
         }
-        return 0;
+        return false;
     }
 
-  private:
-    static sd_event_source* ref(sd_event_source* const& source,
-                                const internal::SdEvent*& sdevent, bool& owned);
-    static void drop(sd_event_source*&& source,
-                     const internal::SdEvent*& sdevent, bool& owned);
+    /** @brief Determines if statistics are collected for the source data */
+    static bool hasStats(const detail::BaseData& data);
+
+    /** @brief Accounts a finished dispatch in the statistics of the source
+     *         The callback may have disabled the collection while running,
+     *         in which case nothing is recorded.
+     *
+     *  @param[in] data    - The data of the dispatched source
+     *  @param[in] start   - The time at which the callback was started
+     *  @param[in] success - Whether the callback returned without throwing
+     */
+    static void recordDispatch(detail::BaseData& data,
+                               std::chrono::steady_clock::time_point start,
+                               bool success);
+
+    /** @brief Takes a new reference on the source of other, if any
+     *         The sd_event interface is shared with the event member, so
+     *         the source handle only stores the pointer and ownership.
+     */
+    void ref(const Base& other);
+    /** @brief Releases the held reference, if owned */
+    void drop();
 
-    stdplus::Copyable<sd_event_source*, const internal::SdEvent*,
-                      bool>::Handle<drop, ref>
-        source;
+    /** @brief The wrapped sd_event_source, nullptr once moved from */
+    sd_event_source* source;
+    /** @brief Whether a reference on source is held */
+    bool owned;
 
     /** @brief A wrapper around deleting the heap allocated base class
      *         This is needed for calls from sd_event destroy callbacks.
@@ -247,23 +424,79 @@ class Base
      * @return 0 on success or a negative errno otherwise
      */
     static int prepareCallback(sd_event_source* source, void* userdata);
+
+    /** @brief A wrapper around the rate limit expire callback that can be
+     *         called from sd-event, counting the throttling periods
+     *
+     * @param[in] source   - The sd_event_source associated with the call
+     * @param[in] userdata - The provided userdata for the source
+     * @return 0 on success or a negative errno otherwise
+     */
+    static int ratelimitExpireCallback(sd_event_source* source,
+                                       void* userdata);
 };
 
 namespace detail
 {
 
-class BaseData : public Base
+/** @class BaseData
+ *  @brief The heap allocated state shared by all copies of a source
+ *         Each source type stores a single object deriving from both its
+ *         non-owning source view and this class, so the state common to all
+ *         sources only costs a vtable pointer and a pointer to the rarely
+ *         used extras.
+ */
+class BaseData
 {
+  public:
+    BaseData() = default;
+    BaseData(const BaseData&) = delete;
+    BaseData& operator=(const BaseData&) = delete;
+    virtual ~BaseData() = default;
+
+    /** @brief Source data is allocated from the internal block pool, so
+     *         sources created and destroyed at a high rate reuse blocks
+     *         instead of going through malloc. Over-aligned data, like a
+     *         StaticIO holding an over-aligned callback, bypasses the pool.
+     */
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size) noexcept;
+    static void* operator new(std::size_t size, std::align_val_t align);
+    static void operator delete(void* ptr, std::size_t size,
+                                std::align_val_t align) noexcept;
+
+  protected:
+    /** @brief Returns the non-owning source view passed to callbacks */
+    virtual Base& get_source() = 0;
+
   private:
-    Base::Callback prepare;
+    /** @brief State only allocated once a prepare callback or statistics
+     *         are requested for the source
+     */
+    struct Extra
+    {
+        Base::Callback prepare;
+        std::optional<Base::Stats> stats;
+        Base::Callback ratelimitExpire;
+        uint64_t throttled = 0;
 
-  public:
-    BaseData(const Base& base);
+        static void* operator new(std::size_t size);
+        static void operator delete(void* ptr, std::size_t size) noexcept;
+    };
+    std::unique_ptr<Extra> extra;
+
+    /** @brief Returns the extras, allocating them if needed */
+    Extra& get_extra();
 
     friend Base;
 };
 
 } // namespace detail
 
+inline bool Base::hasStats(const detail::BaseData& data)
+{
+    return data.extra != nullptr && data.extra->stats.has_value();
+}
+
 } // namespace source
 } // namespace sdeventplus
@@ -1,3 +1,4 @@
+#include <sdeventplus/internal/call.hpp>
 #include <sdeventplus/internal/cexec.hpp>
 #include <sdeventplus/internal/sdevent.hpp>
 #include <sdeventplus/source/child.hpp>
@@ -19,6 +20,14 @@ Child::Child(const Event& event, pid_t pid, int options, Callback&& callback) :
         std::make_unique<detail::ChildData>(*this, std::move(callback)));
 }
 
+Child::Child(const Event& event, PidFd pidfd, int options,
+             Callback&& callback) :
+    Base(event, create_source(event, pidfd, options), std::false_type())
+{
+    set_userdata(
+        std::make_unique<detail::ChildData>(*this, std::move(callback)));
+}
+
 Child::Child(const Child& other, sdeventplus::internal::NoOwn) :
     Base(other, sdeventplus::internal::NoOwn())
 {}
@@ -33,10 +42,61 @@ pid_t Child::get_pid() const
     pid_t pid;
     SDEVENTPLUS_CHECK(
         "sd_event_source_get_child_pid",
-        event.getSdEvent()->sd_event_source_get_child_pid(get(), &pid));
+        internal::call<&internal::SdEvent::sd_event_source_get_child_pid>(
+            event.getSdEvent(), get(), &pid));
     return pid;
 }
 
+int Child::get_pidfd() const
+{
+    return SDEVENTPLUS_CHECK(
+        "sd_event_source_get_child_pidfd",
+        internal::call<&internal::SdEvent::sd_event_source_get_child_pidfd>(
+            event.getSdEvent(), get()));
+}
+
+bool Child::get_pidfd_own() const
+{
+    return SDEVENTPLUS_CHECK(
+        "sd_event_source_get_child_pidfd_own",
+        internal::call<&internal::SdEvent::sd_event_source_get_child_pidfd_own>(
+            event.getSdEvent(), get()));
+}
+
+void Child::set_pidfd_own(bool own) const
+{
+    SDEVENTPLUS_CHECK(
+        "sd_event_source_set_child_pidfd_own",
+        internal::call<&internal::SdEvent::sd_event_source_set_child_pidfd_own>(
+            event.getSdEvent(), get(), static_cast<int>(own)));
+}
+
+bool Child::get_process_own() const
+{
+    return SDEVENTPLUS_CHECK(
+        "sd_event_source_get_child_process_own",
+        internal::call<
+            &internal::SdEvent::sd_event_source_get_child_process_own>(
+            event.getSdEvent(), get()));
+}
+
+void Child::set_process_own(bool own) const
+{
+    SDEVENTPLUS_CHECK(
+        "sd_event_source_set_child_process_own",
+        internal::call<
+            &internal::SdEvent::sd_event_source_set_child_process_own>(
+            event.getSdEvent(), get(), static_cast<int>(own)));
+}
+
+void Child::send_signal(int sig, const siginfo_t* si) const
+{
+    SDEVENTPLUS_CHECK(
+        "sd_event_source_send_child_signal",
+        internal::call<&internal::SdEvent::sd_event_source_send_child_signal>(
+            event.getSdEvent(), get(), sig, si, 0));
+}
+
 detail::ChildData& Child::get_userdata() const
 {
     return static_cast<detail::ChildData&>(Base::get_userdata());
@@ -53,8 +113,21 @@ sd_event_source* Child::create_source(const Event& event, pid_t pid,
     sd_event_source* source;
     SDEVENTPLUS_CHECK(
         "sd_event_add_child",
-        event.getSdEvent()->sd_event_add_child(
-            event.get(), &source, pid, options, childCallback, nullptr));
+        internal::call<&internal::SdEvent::sd_event_add_child>(
+            event.getSdEvent(), event.get(), &source, pid, options,
+            childCallback, nullptr));
+    return source;
+}
+
+sd_event_source* Child::create_source(const Event& event, PidFd pidfd,
+                                      int options)
+{
+    sd_event_source* source;
+    SDEVENTPLUS_CHECK(
+        "sd_event_add_child_pidfd",
+        internal::call<&internal::SdEvent::sd_event_add_child_pidfd>(
+            event.getSdEvent(), event.get(), &source, pidfd.fd, options,
+            childCallback, nullptr));
     return source;
 }
 
@@ -69,10 +142,14 @@ namespace detail
 {
 
 ChildData::ChildData(const Child& base, Child::Callback&& callback) :
-    Child(base, sdeventplus::internal::NoOwn()), BaseData(base),
-    callback(std::move(callback))
+    Child(base, sdeventplus::internal::NoOwn()), callback(std::move(callback))
 {}
 
+Base& ChildData::get_source()
+{
+    return *this;
+}
+
 } // namespace detail
 
 } // namespace source
@@ -16,6 +16,14 @@ namespace detail
 class ChildData;
 } // namespace detail
 
+/** @brief A pidfd referring to a child process, see pidfd_open(2)
+ *         Selects the Child constructor watching the pidfd rather than a pid.
+ */
+struct PidFd
+{
+    int fd;
+};
+
 /** @class Child
  *  @brief A wrapper around the sd_event_source child type
  *         See sd_event_add_child(3) for more information
@@ -38,6 +46,20 @@ class Child : public Base
      */
     Child(const Event& event, pid_t pid, int options, Callback&& callback);
 
+    /** @brief Adds a new child source handler watching a pidfd to the Event
+     *         Unlike pids, a pidfd can not be recycled for another process,
+     *         and sd-event waits on it directly when only WEXITED is
+     *         requested. The pidfd is not consumed unless set_pidfd_own() is
+     *         called.
+     *
+     *  @param[in] event    - The event to attach the handler
+     *  @param[in] pidfd    - The pidfd of the child to monitor
+     *  @param[in] options  - An OR-ed mask that determines triggers
+     *                        See waitid(2) for further information
+     *  @param[in] callback - The function executed on event dispatch
+     */
+    Child(const Event& event, PidFd pidfd, int options, Callback&& callback);
+
     /** @brief Constructs a non-owning child source handler
      *         Does not own the passed reference to the source because
      *         this is meant to be used only as a reference inside an event
@@ -62,6 +84,54 @@ class Child : public Base
      */
     pid_t get_pid() const;
 
+    /** @brief Gets the pidfd of the child process being watched
+     *         Sources created from a pid get one allocated by sd-event.
+     *
+     *  @return The child pidfd
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    int get_pidfd() const;
+
+    /** @brief Gets whether the pidfd is closed along with the source
+     *
+     *  @return 'true' if the source owns the pidfd
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    bool get_pidfd_own() const;
+
+    /** @brief Sets whether the pidfd is closed along with the source
+     *
+     *  @param[in] own - 'true' to hand the pidfd over to the source
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    void set_pidfd_own(bool own) const;
+
+    /** @brief Gets whether the child is killed along with the source
+     *
+     *  @return 'true' if the source owns the child process
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    bool get_process_own() const;
+
+    /** @brief Sets whether the child is killed along with the source
+     *         An owned child that did not exit yet is sent SIGKILL and
+     *         reaped when the source is destroyed.
+     *
+     *  @param[in] own - 'true' to hand the child process over to the source
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    void set_process_own(bool own) const;
+
+    /** @brief Sends a signal to the child process through its pidfd
+     *         Unlike kill(2), this can never reach a process reusing the pid.
+     *
+     *  @param[in] sig - The signal to send
+     *  @param[in] si  - The optional siginfo sent along, see
+     *                   pidfd_send_signal(2)
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    void send_signal(int sig, const siginfo_t* si = nullptr) const;
+
   private:
     /** @brief Returns a reference to the source owned child
      *
@@ -86,6 +156,17 @@ class Child : public Base
     static sd_event_source* create_source(const Event& event, pid_t pid,
                                           int options);
 
+    /** @brief Creates a new child source watching a pidfd attached to the Event
+     *
+     *  @param[in] event   - The event to attach the handler
+     *  @param[in] pidfd   - The pidfd of the child to monitor
+     *  @param[in] options - An OR-ed mask that determines triggers
+     *  @throws SdEventError for underlying sd_event errors
+     *  @return A new sd_event_source
+     */
+    static sd_event_source* create_source(const Event& event, PidFd pidfd,
+                                          int options);
+
     /** @brief A wrapper around the callback that can be called from sd-event
      *
      *  @param[in] source   - The sd_event_source associated with the call
@@ -107,6 +188,9 @@ class ChildData : public Child, public BaseData
   public:
     ChildData(const Child& base, Child::Callback&& callback);
 
+  protected:
+    Base& get_source() override;
+
     friend Child;
 };
 
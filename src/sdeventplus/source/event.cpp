@@ -1,3 +1,4 @@
+#include <sdeventplus/internal/call.hpp>
 #include <sdeventplus/internal/cexec.hpp>
 #include <sdeventplus/internal/sdevent.hpp>
 #include <sdeventplus/source/event.hpp>
@@ -59,10 +60,15 @@ namespace detail
 
 EventBaseData::EventBaseData(const EventBase& base,
                              EventBase::Callback&& callback) :
-    EventBase(base, sdeventplus::internal::NoOwn()), BaseData(base),
+    EventBase(base, sdeventplus::internal::NoOwn()),
     callback(std::move(callback))
 {}
 
+Base& EventBaseData::get_source()
+{
+    return *this;
+}
+
 } // namespace detail
 
 Defer::Defer(const Event& event, Callback&& callback) :
@@ -80,5 +86,30 @@ Exit::Exit(const Event& event, Callback&& callback) :
               std::move(callback))
 {}
 
+MemoryPressure::MemoryPressure(const Event& event, Callback&& callback) :
+    EventBase("sd_event_add_memory_pressure",
+              &internal::SdEvent::sd_event_add_memory_pressure, event,
+              std::move(callback))
+{}
+
+void MemoryPressure::set_type(const char* type) const
+{
+    SDEVENTPLUS_CHECK(
+        "sd_event_source_set_memory_pressure_type",
+        internal::call<
+            &internal::SdEvent::sd_event_source_set_memory_pressure_type>(
+            event.getSdEvent(), get(), type));
+}
+
+void MemoryPressure::set_period(SdEventDuration threshold,
+                                SdEventDuration window) const
+{
+    SDEVENTPLUS_CHECK(
+        "sd_event_source_set_memory_pressure_period",
+        internal::call<
+            &internal::SdEvent::sd_event_source_set_memory_pressure_period>(
+            event.getSdEvent(), get(), threshold.count(), window.count()));
+}
+
 } // namespace source
 } // namespace sdeventplus
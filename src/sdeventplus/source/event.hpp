@@ -106,6 +106,9 @@ class EventBaseData : public EventBase, public BaseData
   public:
     EventBaseData(const EventBase& base, EventBase::Callback&& callback);
 
+  protected:
+    Base& get_source() override;
+
     friend EventBase;
 };
 
@@ -150,5 +153,49 @@ class Exit : public EventBase
     Exit(const Event& event, Callback&& callback);
 };
 
+/** @class MemoryPressure
+ *  @brief A wrapper around the sd_event_source memory pressure type
+ *         See sd_event_add_memory_pressure(3) for more information
+ *         Requires sdeventplus to be built against libsystemd 254 or
+ *         newer, otherwise the constructor always throws with EOPNOTSUPP.
+ *         It also throws with EOPNOTSUPP when the kernel lacks PSI, and
+ *         with EHOSTDOWN when turned off through $MEMORY_PRESSURE_WATCH.
+ */
+class MemoryPressure : public EventBase
+{
+  public:
+    /** @brief Adds a new memory pressure source handler to the Event
+     *         Executes the callback whenever the kernel reports memory
+     *         pressure on the cgroup of the process through PSI.
+     *         See sd_event_add_memory_pressure(3) for more information
+     *
+     *  @param[in] event    - The event to attach the handler
+     *  @param[in] callback - The function executed on event dispatch
+     *  @throws SdEventError for underlying sd_event errors, with EOPNOTSUPP
+     *          if PSI is unavailable in the kernel or in the libsystemd
+     *          built against, and EHOSTDOWN if turned off through
+     *          $MEMORY_PRESSURE_WATCH
+     */
+    MemoryPressure(const Event& event, Callback&& callback);
+
+    /** @brief Sets the kind of memory pressure watched
+     *         Must be called before the event loop first polls the source.
+     *
+     *  @param[in] type - "some" or "full", see the PSI kernel documentation
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    void set_type(const char* type) const;
+
+    /** @brief Sets the amount of stalls within a window which triggers the
+     *         callback. Must be called before the event loop first polls the
+     *         source.
+     *
+     *  @param[in] threshold - Time the tasks stalled on memory in the window
+     *  @param[in] window    - Length of the window
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    void set_period(SdEventDuration threshold, SdEventDuration window) const;
+};
+
 } // namespace source
 } // namespace sdeventplus
@@ -0,0 +1,317 @@
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/internal/call.hpp>
+#include <sdeventplus/internal/cexec.hpp>
+#include <sdeventplus/internal/sdevent.hpp>
+#include <sdeventplus/source/inotify.hpp>
+#include <sdeventplus/source/time.hpp>
+#include <sdeventplus/types.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sdeventplus
+{
+namespace source
+{
+
+namespace detail
+{
+
+/** @class InotifyCoalescer
+ *  @brief The IN_MODIFY events of an Inotify source waiting for their window
+ *         to elapse, and the time source dispatching them
+ */
+class InotifyCoalescer
+{
+  public:
+    InotifyCoalescer(InotifyData& data, SdEventDuration window) :
+        window(window), data(data),
+        clock(Event(data.get_event(), sdeventplus::internal::NoOwn()))
+    {}
+
+    /** @brief Handles an event before it is dispatched
+     *
+     *  @param[in] event - The inotify event observed
+     *  @throws SdEventError for underlying sd_event errors
+     *  @return 'true' if the event was merged and must not be dispatched
+     */
+    bool absorb(const struct inotify_event* event)
+    {
+        if (pending.empty() && window.count() == 0)
+        {
+            return false;
+        }
+        const std::string_view name(event->len > 0 ? event->name : "");
+        auto it = std::find_if(pending.begin(), pending.end(),
+                               [&](const Pending& p) {
+                                   return p.wd == event->wd && p.name == name;
+                               });
+        if (window.count() > 0 && (event->mask & IN_MODIFY))
+        {
+            if (it != pending.end())
+            {
+                it->mask |= event->mask;
+                coalesced++;
+                return true;
+            }
+            const auto deadline = clock.now() + window;
+            auto pos = std::upper_bound(
+                pending.begin(), pending.end(), deadline,
+                [](auto d, const Pending& p) { return d < p.deadline; });
+            pos = pending.insert(pos, {std::string(name), event->wd,
+                                       event->mask, deadline});
+            if (pos == pending.begin())
+            {
+                arm();
+            }
+            return true;
+        }
+        if (it != pending.end())
+        {
+            // Keep the merged modification ahead of the event which follows
+            Pending p = std::move(*it);
+            pending.erase(it);
+            arm();
+            deliver(p);
+        }
+        return false;
+    }
+
+    SdEventDuration window;
+    uint64_t coalesced = 0;
+
+  private:
+    struct Pending
+    {
+        std::string name;
+        int wd;
+        uint32_t mask;
+        Clock<ClockId::Monotonic>::time_point deadline;
+    };
+
+    InotifyData& data;
+    Clock<ClockId::Monotonic> clock;
+    /** @brief The merged events, in the order their windows elapse */
+    std::vector<Pending> pending;
+    std::optional<Time<ClockId::Monotonic>> timer;
+
+    /** @brief Schedules the time source for the first pending event */
+    void arm()
+    {
+        if (pending.empty())
+        {
+            if (timer)
+            {
+                timer->set_enabled(Enabled::Off);
+            }
+            return;
+        }
+        const auto deadline = pending.front().deadline;
+        if (!timer)
+        {
+            timer.emplace(data.get_event(), deadline,
+                          std::chrono::milliseconds(1),
+                          [this](Time<ClockId::Monotonic>&, auto now) {
+                              expire(now);
+                          });
+            timer->set_enabled(Enabled::OneShot);
+            return;
+        }
+        timer->set_time(deadline);
+        timer->set_enabled(Enabled::OneShot);
+    }
+
+    /** @brief Dispatches the events whose window elapsed */
+    void expire(Clock<ClockId::Monotonic>::time_point now)
+    {
+        // The callbacks may drop the last reference to the inotify source
+        Inotify keep(data);
+        auto end = std::find_if(pending.begin(), pending.end(),
+                                [&](const Pending& p) {
+                                    return p.deadline > now;
+                                });
+        std::vector<Pending> due(std::make_move_iterator(pending.begin()),
+                                 std::make_move_iterator(end));
+        pending.erase(pending.begin(), end);
+        arm();
+        for (const auto& p : due)
+        {
+            deliver(p);
+        }
+    }
+
+    /** @brief Dispatches a merged event to the callback of the source */
+    void deliver(const Pending& p)
+    {
+        alignas(struct inotify_event) char
+            buf[sizeof(struct inotify_event) + NAME_MAX + 1] = {};
+        auto event = reinterpret_cast<struct inotify_event*>(buf);
+        event->wd = p.wd;
+        event->mask = p.mask;
+        event->len = p.name.empty() ? 0 : p.name.size() + 1;
+        std::memcpy(event->name, p.name.c_str(), event->len);
+        Inotify::dispatch(static_cast<BaseData*>(&data), event);
+    }
+};
+
+} // namespace detail
+
+Inotify::Inotify(const Event& event, const char* path, uint32_t mask,
+                 Callback&& callback) :
+    Base(event, create_source(event, path, mask), std::false_type())
+{
+    set_userdata(
+        std::make_unique<detail::InotifyData>(*this, std::move(callback)));
+}
+
+Inotify::Inotify(const Event& event, int fd, uint32_t mask,
+                 Callback&& callback) :
+    Base(event, create_source(event, fd, mask), std::false_type())
+{
+    set_userdata(
+        std::make_unique<detail::InotifyData>(*this, std::move(callback)));
+}
+
+Inotify::Inotify(const Inotify& other, sdeventplus::internal::NoOwn) :
+    Base(other, sdeventplus::internal::NoOwn())
+{}
+
+void Inotify::set_callback(Callback&& callback)
+{
+    get_userdata().callback = std::move(callback);
+}
+
+uint32_t Inotify::get_mask() const
+{
+    uint32_t mask;
+    SDEVENTPLUS_CHECK(
+        "sd_event_source_get_inotify_mask",
+        internal::call<&internal::SdEvent::sd_event_source_get_inotify_mask>(
+            event.getSdEvent(), get(), &mask));
+    return mask;
+}
+
+void Inotify::set_coalesce(std::optional<SdEventDuration> window) const
+{
+    auto& data = get_userdata();
+    const auto w = window.value_or(SdEventDuration::zero());
+    if (data.coalescer)
+    {
+        // Events already merged still wait for their window to elapse
+        data.coalescer->window = w;
+    }
+    else if (w.count() > 0)
+    {
+        data.coalescer = std::make_unique<detail::InotifyCoalescer>(data, w);
+    }
+}
+
+std::optional<SdEventDuration> Inotify::get_coalesce() const
+{
+    const auto& data = get_userdata();
+    if (!data.coalescer || data.coalescer->window.count() == 0)
+    {
+        return std::nullopt;
+    }
+    return data.coalescer->window;
+}
+
+uint64_t Inotify::get_coalesced() const
+{
+    const auto& data = get_userdata();
+    return data.coalescer ? data.coalescer->coalesced : 0;
+}
+
+detail::InotifyData& Inotify::get_userdata() const
+{
+    return static_cast<detail::InotifyData&>(Base::get_userdata());
+}
+
+Inotify::Callback& Inotify::get_callback()
+{
+    return get_userdata().callback;
+}
+
+sd_event_source* Inotify::create_source(const Event& event, const char* path,
+                                        uint32_t mask)
+{
+    sd_event_source* source;
+    SDEVENTPLUS_CHECK(
+        "sd_event_add_inotify",
+        internal::call<&internal::SdEvent::sd_event_add_inotify>(
+            event.getSdEvent(), event.get(), &source, path, mask,
+            inotifyCallback, nullptr));
+    return source;
+}
+
+sd_event_source* Inotify::create_source(const Event& event, int fd,
+                                        uint32_t mask)
+{
+    sd_event_source* source;
+    SDEVENTPLUS_CHECK(
+        "sd_event_add_inotify_fd",
+        internal::call<&internal::SdEvent::sd_event_add_inotify_fd>(
+            event.getSdEvent(), event.get(), &source, fd, mask,
+            inotifyCallback, nullptr));
+    return source;
+}
+
+int Inotify::dispatch(void* userdata, const struct inotify_event* event)
+{
+    return sourceCallback<Callback, detail::InotifyData,
+                          &Inotify::get_callback>("inotifyCallback", nullptr,
+                                                  userdata, event);
+}
+
+int Inotify::inotifyCallback(sd_event_source*,
+                             const struct inotify_event* event, void* userdata)
+{
+    if (userdata != nullptr)
+    {
+        auto& data = static_cast<detail::InotifyData&>(
+            *reinterpret_cast<detail::BaseData*>(userdata));
+        try
+        {
+            if (data.coalescer && data.coalescer->absorb(event))
+            {
+                return 0;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            // Dispatch the event right away rather than losing it
+            fprintf(stderr, "sdeventplus: inotifyCallback: %s\n", e.what());
+        }
+    }
+    return dispatch(userdata, event);
+}
+
+namespace detail
+{
+
+InotifyData::InotifyData(const Inotify& base, Inotify::Callback&& callback) :
+    Inotify(base, sdeventplus::internal::NoOwn()), callback(std::move(callback))
+{}
+
+InotifyData::~InotifyData() = default;
+
+Base& InotifyData::get_source()
+{
+    return *this;
+}
+
+} // namespace detail
+
+} // namespace source
+} // namespace sdeventplus
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <sys/inotify.h>
+
+#include <function2/function2.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/base.hpp>
+#include <sdeventplus/types.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace sdeventplus
+{
+namespace source
+{
+
+namespace detail
+{
+class InotifyData;
+class InotifyCoalescer;
+} // namespace detail
+
+/** @class Inotify
+ *  @brief A wrapper around the sd_event_source inotify type
+ *         See sd_event_add_inotify(3) for more information
+ */
+class Inotify : public Base
+{
+  public:
+    /** @brief Type of the user provided callback function */
+    using Callback = fu2::unique_function<void(
+        Inotify& source, const struct inotify_event* event)>;
+
+    /** @brief Creates a new inotify event source on the provided event loop
+     *         This type of source defaults to Enabled::On, executing the
+     *         callback for each inotify event observed on the path.
+     *
+     *  @param[in] event    - The event to attach the handler
+     *  @param[in] path     - The path of the inode to watch
+     *  @param[in] mask     - The inotify events to watch, see inotify(7)
+     *  @param[in] callback - The function executed on event dispatch
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    Inotify(const Event& event, const char* path, uint32_t mask,
+            Callback&& callback);
+
+    /** @brief Creates a new inotify event source watching an open inode
+     *         The file descriptor is not consumed and may be an O_PATH one.
+     *
+     *  @param[in] event    - The event to attach the handler
+     *  @param[in] fd       - The file descriptor of the inode to watch
+     *  @param[in] mask     - The inotify events to watch, see inotify(7)
+     *  @param[in] callback - The function executed on event dispatch
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    Inotify(const Event& event, int fd, uint32_t mask, Callback&& callback);
+
+    /** @brief Constructs a non-owning inotify source handler
+     *         Does not own the passed reference to the source because
+     *         this is meant to be used only as a reference inside an event
+     *         source.
+     *  @internal
+     *
+     *  @param[in] other - The source wrapper to copy
+     *  @param[in]       - Signifies that this new copy is non-owning
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    Inotify(const Inotify& other, sdeventplus::internal::NoOwn);
+
+    /** @brief Sets the callback
+     *
+     *  @param[in] callback - The function executed on event dispatch
+     */
+    void set_callback(Callback&& callback);
+
+    /** @brief Gets the inotify events watched by the source
+     *
+     *  @throws SdEventError for underlying sd_event errors
+     *  @return The inotify mask
+     */
+    uint32_t get_mask() const;
+
+    /** @brief Merges repeated IN_MODIFY events on the same path
+     *         The first IN_MODIFY event of a path opens a window, the
+     *         following ones within it are merged, and a single IN_MODIFY
+     *         event is dispatched once the window elapsed. Any other event
+     *         on the path dispatches the merged one right before itself.
+     *
+     *  @param[in] window - The time modifications are merged over, or
+     *                      std::nullopt to dispatch every event again
+     */
+    void set_coalesce(std::optional<SdEventDuration> window) const;
+
+    /** @brief Gets the window IN_MODIFY events are merged over
+     *
+     *  @return The window, or std::nullopt if events are not merged
+     */
+    std::optional<SdEventDuration> get_coalesce() const;
+
+    /** @brief Gets the number of IN_MODIFY events merged into an earlier one
+     *
+     *  @return The number of events which were not dispatched
+     */
+    uint64_t get_coalesced() const;
+
+  private:
+    /** @brief Returns a reference to the source owned inotify
+     *
+     *  @return A reference to the inotify
+     */
+    detail::InotifyData& get_userdata() const;
+
+    /** @brief Returns a reference to the callback executed for this source
+     *
+     *  @return A reference to the callback
+     */
+    Callback& get_callback();
+
+    /** @brief Creates a new inotify source attached to the Event
+     *
+     *  @param[in] event - The event to attach the handler
+     *  @param[in] path  - The path of the inode to watch
+     *  @param[in] mask  - The inotify events to watch
+     *  @throws SdEventError for underlying sd_event errors
+     *  @return A new sd_event_source
+     */
+    static sd_event_source* create_source(const Event& event, const char* path,
+                                          uint32_t mask);
+
+    /** @brief Creates a new inotify source attached to the Event
+     *
+     *  @param[in] event - The event to attach the handler
+     *  @param[in] fd    - The file descriptor of the inode to watch
+     *  @param[in] mask  - The inotify events to watch
+     *  @throws SdEventError for underlying sd_event errors
+     *  @return A new sd_event_source
+     */
+    static sd_event_source* create_source(const Event& event, int fd,
+                                          uint32_t mask);
+
+    /** @brief Runs the callback of the source for an event
+     *
+     *  @param[in] userdata - The userdata of the source
+     *  @param[in] event    - The inotify event passed to the callback
+     *  @return 0 on success or a negative errno otherwise
+     */
+    static int dispatch(void* userdata, const struct inotify_event* event);
+
+    /** @brief A wrapper around the callback that can be called from sd-event
+     *
+     *  @param[in] source   - The sd_event_source associated with the call
+     *  @param[in] event    - The inotify event observed
+     *  @param[in] userdata - The provided userdata for the source
+     *  @return 0 on success or a negative errno otherwise
+     */
+    static int inotifyCallback(sd_event_source* source,
+                               const struct inotify_event* event,
+                               void* userdata);
+
+    friend detail::InotifyCoalescer;
+};
+
+namespace detail
+{
+
+class InotifyData : public Inotify, public BaseData
+{
+  private:
+    Inotify::Callback callback;
+    std::unique_ptr<InotifyCoalescer> coalescer;
+
+  public:
+    InotifyData(const Inotify& base, Inotify::Callback&& callback);
+    ~InotifyData();
+
+  protected:
+    Base& get_source() override;
+
+    friend Inotify;
+};
+
+} // namespace detail
+
+} // namespace source
+} // namespace sdeventplus
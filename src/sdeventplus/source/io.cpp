@@ -1,8 +1,17 @@
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <sdeventplus/internal/call.hpp>
 #include <sdeventplus/internal/cexec.hpp>
 #include <sdeventplus/internal/sdevent.hpp>
 #include <sdeventplus/source/io.hpp>
 #include <sdeventplus/types.hpp>
 
+#include <algorithm>
+#include <cerrno>
+#include <expected>
+#include <stdexcept>
+#include <system_error>
 #include <type_traits>
 #include <utility>
 
@@ -12,31 +21,58 @@ namespace source
 {
 
 IO::IO(const Event& event, int fd, uint32_t events, Callback&& callback) :
-    Base(event, create_source(event, fd, events), std::false_type())
+    Base(event, create_source(event, fd, events, ioCallback),
+         std::false_type())
 {
     set_userdata(std::make_unique<detail::IOData>(*this, std::move(callback)));
 }
 
+IO::IO(const Event& event, sd_event_io_handler_t handler, int fd,
+       uint32_t events) :
+    Base(event, create_source(event, fd, events, handler), std::false_type())
+{}
+
 IO::IO(const IO& other, sdeventplus::internal::NoOwn) :
     Base(other, sdeventplus::internal::NoOwn())
 {}
 
 void IO::set_callback(Callback&& callback)
 {
-    get_userdata().callback = std::move(callback);
+    // Sources derived from IO keep their own userdata type
+    auto data = dynamic_cast<detail::IOData*>(&Base::get_userdata());
+    if (data == nullptr)
+    {
+        throw std::runtime_error("IO::set_callback on a derived source");
+    }
+    data->callback = std::move(callback);
 }
 
 int IO::get_fd() const
 {
     return SDEVENTPLUS_CHECK(
         "sd_event_source_get_io_fd",
-        event.getSdEvent()->sd_event_source_get_io_fd(get()));
+        internal::call<&internal::SdEvent::sd_event_source_get_io_fd>(
+            event.getSdEvent(), get()));
 }
 
 void IO::set_fd(int fd) const
 {
-    SDEVENTPLUS_CHECK("sd_event_source_set_io_fd",
-                      event.getSdEvent()->sd_event_source_set_io_fd(get(), fd));
+    SDEVENTPLUS_CHECK(
+        "sd_event_source_set_io_fd",
+        internal::call<&internal::SdEvent::sd_event_source_set_io_fd>(
+            event.getSdEvent(), get(), fd));
+}
+
+std::expected<void, std::error_code> IO::try_set_fd(int fd) const noexcept
+{
+    if (get_or_null() == nullptr)
+    {
+        return internal::movedFrom();
+    }
+    return internal::expect(
+               internal::call<&internal::SdEvent::sd_event_source_set_io_fd>(
+                   event.getSdEvent(), get_or_null(), fd))
+        .transform([](int) {});
 }
 
 uint32_t IO::get_events() const
@@ -44,7 +80,8 @@ uint32_t IO::get_events() const
     uint32_t events;
     SDEVENTPLUS_CHECK(
         "sd_event_source_get_io_events",
-        event.getSdEvent()->sd_event_source_get_io_events(get(), &events));
+        internal::call<&internal::SdEvent::sd_event_source_get_io_events>(
+            event.getSdEvent(), get(), &events));
     return events;
 }
 
@@ -52,7 +89,22 @@ void IO::set_events(uint32_t events) const
 {
     SDEVENTPLUS_CHECK(
         "sd_event_source_set_io_events",
-        event.getSdEvent()->sd_event_source_set_io_events(get(), events));
+        internal::call<&internal::SdEvent::sd_event_source_set_io_events>(
+            event.getSdEvent(), get(), events));
+}
+
+std::expected<void, std::error_code>
+    IO::try_set_events(uint32_t events) const noexcept
+{
+    if (get_or_null() == nullptr)
+    {
+        return internal::movedFrom();
+    }
+    return internal::expect(
+               internal::call<
+                   &internal::SdEvent::sd_event_source_set_io_events>(
+                   event.getSdEvent(), get_or_null(), events))
+        .transform([](int) {});
 }
 
 uint32_t IO::get_revents() const
@@ -60,7 +112,8 @@ uint32_t IO::get_revents() const
     uint32_t revents;
     SDEVENTPLUS_CHECK(
         "sd_event_source_get_io_revents",
-        event.getSdEvent()->sd_event_source_get_io_revents(get(), &revents));
+        internal::call<&internal::SdEvent::sd_event_source_get_io_revents>(
+            event.getSdEvent(), get(), &revents));
     return revents;
 }
 
@@ -74,12 +127,15 @@ IO::Callback& IO::get_callback()
     return get_userdata().callback;
 }
 
-sd_event_source* IO::create_source(const Event& event, int fd, uint32_t events)
+sd_event_source* IO::create_source(const Event& event, int fd, uint32_t events,
+                                   sd_event_io_handler_t handler)
 {
     sd_event_source* source;
-    SDEVENTPLUS_CHECK("sd_event_add_io", event.getSdEvent()->sd_event_add_io(
-                                             event.get(), &source, fd, events,
-                                             ioCallback, nullptr));
+    SDEVENTPLUS_CHECK(
+        "sd_event_add_io",
+        internal::call<&internal::SdEvent::sd_event_add_io>(
+            event.getSdEvent(), event.get(), &source, fd, events, handler,
+            nullptr));
     return source;
 }
 
@@ -90,14 +146,183 @@ int IO::ioCallback(sd_event_source* source, int fd, uint32_t revents,
         "ioCallback", source, userdata, fd, revents);
 }
 
+DrainIO::Reader::Reader(int fd) noexcept : fd(fd) {}
+
+size_t DrainIO::Reader::read(void* buf, size_t len)
+{
+    if (is_drained)
+    {
+        return 0;
+    }
+    ssize_t r;
+    do
+    {
+        r = ::read(fd, buf, len);
+    } while (r < 0 && errno == EINTR);
+    return account(r, "read");
+}
+
+size_t DrainIO::Reader::recv(void* buf, size_t len, int flags)
+{
+    if (is_drained)
+    {
+        return 0;
+    }
+    ssize_t r;
+    do
+    {
+        r = ::recv(fd, buf, len, flags);
+    } while (r < 0 && errno == EINTR);
+    return account(r, "recv");
+}
+
+int DrainIO::Reader::get_fd() const noexcept
+{
+    return fd;
+}
+
+bool DrainIO::Reader::drained() const noexcept
+{
+    return is_drained;
+}
+
+bool DrainIO::Reader::eof() const noexcept
+{
+    return is_eof;
+}
+
+size_t DrainIO::Reader::get_bytes() const noexcept
+{
+    return bytes;
+}
+
+size_t DrainIO::Reader::account(ssize_t r, const char* name)
+{
+    if (r < 0)
+    {
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+            throw std::system_error(errno, std::generic_category(), name);
+        }
+        is_drained = true;
+        return 0;
+    }
+    if (r == 0)
+    {
+        is_drained = true;
+        is_eof = true;
+        return 0;
+    }
+    bytes += r;
+    return r;
+}
+
+DrainIO::DrainIO(const Event& event, int fd, uint32_t events,
+                 Callback&& callback) :
+    IO(event, drainCallback, fd, events | EPOLLET)
+{
+    set_userdata(
+        std::make_unique<detail::DrainIOData>(*this, std::move(callback)));
+}
+
+DrainIO::DrainIO(const DrainIO& other, sdeventplus::internal::NoOwn) :
+    IO(other, sdeventplus::internal::NoOwn())
+{}
+
+void DrainIO::set_callback(Callback&& callback)
+{
+    get_userdata().callback = std::move(callback);
+}
+
+uint64_t DrainIO::get_rearms() const
+{
+    return get_userdata().rearms;
+}
+
+detail::DrainIOData& DrainIO::get_userdata() const
+{
+    return static_cast<detail::DrainIOData&>(Base::get_userdata());
+}
+
+DrainIO::Callback& DrainIO::get_callback()
+{
+    return get_userdata().callback;
+}
+
+int DrainIO::rearm() const
+{
+    // The callback may have dropped the last reference to the source, which
+    // sd-event then detached from the loop and only frees after the dispatch
+    if (internal::call<&internal::SdEvent::sd_event_source_get_event>(
+            event.getSdEvent(), get()) == nullptr)
+    {
+        return 0;
+    }
+    int enabled;
+    int r = internal::call<&internal::SdEvent::sd_event_source_get_enabled>(
+        event.getSdEvent(), get(), &enabled);
+    if (r < 0 || enabled == SD_EVENT_OFF)
+    {
+        // Disabled and oneshot sources are re-armed when enabled again
+        return std::min(r, 0);
+    }
+    uint32_t events;
+    r = internal::call<&internal::SdEvent::sd_event_source_get_io_events>(
+        event.getSdEvent(), get(), &events);
+    if (r < 0)
+    {
+        return r;
+    }
+    r = internal::call<&internal::SdEvent::sd_event_source_set_io_events>(
+        event.getSdEvent(), get(), events);
+    return r < 0 ? r : 1;
+}
+
+int DrainIO::drainCallback(sd_event_source* source, int fd, uint32_t revents,
+                           void* userdata)
+{
+    Reader reader(fd);
+    int r = sourceCallback<Callback, detail::DrainIOData,
+                           &DrainIO::get_callback>("drainCallback", source,
+                                                   userdata, reader, revents);
+    // Readable data may be left behind unless the Reader hit EAGAIN or end
+    // of file. Rearming after a write or error only dispatch would raise the
+    // same persistent readiness again on every iteration.
+    if (r < 0 || !(revents & EPOLLIN) || reader.drained())
+    {
+        return r;
+    }
+    auto& data = static_cast<detail::DrainIOData&>(
+        *reinterpret_cast<detail::BaseData*>(userdata));
+    r = data.rearm();
+    if (r > 0)
+    {
+        data.rearms++;
+    }
+    return std::min(r, 0);
+}
+
 namespace detail
 {
 
 IOData::IOData(const IO& base, IO::Callback&& callback) :
-    IO(base, sdeventplus::internal::NoOwn()), BaseData(base),
-    callback(std::move(callback))
+    IO(base, sdeventplus::internal::NoOwn()), callback(std::move(callback))
 {}
 
+Base& IOData::get_source()
+{
+    return *this;
+}
+
+DrainIOData::DrainIOData(const DrainIO& base, DrainIO::Callback&& callback) :
+    DrainIO(base, sdeventplus::internal::NoOwn()), callback(std::move(callback))
+{}
+
+Base& DrainIOData::get_source()
+{
+    return *this;
+}
+
 } // namespace detail
 
 } // namespace source
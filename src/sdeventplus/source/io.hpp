@@ -1,12 +1,18 @@
 #pragma once
 
+#include <sys/epoll.h>
 #include <systemd/sd-event.h>
 
 #include <function2/function2.hpp>
 #include <sdeventplus/source/base.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <expected>
+#include <memory>
+#include <system_error>
 #include <type_traits>
+#include <utility>
 
 namespace sdeventplus
 {
@@ -16,6 +22,9 @@ namespace source
 namespace detail
 {
 class IOData;
+template <typename F>
+class StaticIOData;
+class DrainIOData;
 } // namespace detail
 
 /** @class IO
@@ -53,6 +62,8 @@ class IO : public Base
     /** @brief Sets the callback
      *
      *  @param[in] callback - The function executed on event dispatch
+     *  @throws std::runtime_error if the source is a StaticIO or DrainIO,
+     *          which hold a different callback type
      */
     void set_callback(Callback&& callback);
 
@@ -70,6 +81,14 @@ class IO : public Base
      */
     void set_fd(int fd) const;
 
+    /** @brief Sets the file descriptor the source watches without throwing
+     *
+     *  @param[in] fd - The file descriptor to watch
+     *  @return Nothing, or the error reported by sd_event,
+     *          std::errc::bad_file_descriptor if the source was moved from
+     */
+    std::expected<void, std::error_code> try_set_fd(int fd) const noexcept;
+
     /** @brief Gets the events mask used to determine what
      *         events trigger the callback action
      *
@@ -86,6 +105,16 @@ class IO : public Base
      */
     void set_events(uint32_t events) const;
 
+    /** @brief Sets the events mask used to determine what events
+     *         trigger the callback handler without throwing
+     *
+     *  @param[in] events - The events mask
+     *  @return Nothing, or the error reported by sd_event,
+     *          std::errc::bad_file_descriptor if the source was moved from
+     */
+    std::expected<void, std::error_code>
+        try_set_events(uint32_t events) const noexcept;
+
     /** @brief Gets the events mask describing the events
      *         seen in the most recent callback
      *
@@ -94,6 +123,24 @@ class IO : public Base
      */
     uint32_t get_revents() const;
 
+  protected:
+    /** @brief Adds a new IO source to the Event dispatching to the given
+     *         handler. The caller is responsible for setting the userdata
+     *         expected by the handler.
+     *
+     *         The handler comes before the other arguments so a nullptr
+     *         callback never selects this constructor.
+     *
+     *  @param[in] event   - The event to attach the handler
+     *  @param[in] handler - The sd-event handler run on event dispatch
+     *  @param[in] fd      - The file descriptor producing the events
+     *  @param[in] events  - The event mask passed which determines triggers
+     *                       See epoll_ctl(2) for more info on the mask
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    IO(const Event& event, sd_event_io_handler_t handler, int fd,
+       uint32_t events);
+
   private:
     /** @brief Returns a reference to the source owned io
      *
@@ -109,15 +156,17 @@ class IO : public Base
 
     /** @brief Creates a new IO source attached to the Event
      *
-     *  @param[in] event  - The event to attach the handler
-     *  @param[in] fd     - The file descriptor producing the events
-     *  @param[in] events - The event mask passed which determines triggers
-     *                      See epoll_ctl(2) for more info on the mask
+     *  @param[in] event   - The event to attach the handler
+     *  @param[in] fd      - The file descriptor producing the events
+     *  @param[in] events  - The event mask passed which determines triggers
+     *                       See epoll_ctl(2) for more info on the mask
+     *  @param[in] handler - The sd-event handler run on event dispatch
      *  @throws SdEventError for underlying sd_event errors
      *  @return A new sd_event_source
      */
     static sd_event_source* create_source(const Event& event, int fd,
-                                          uint32_t events);
+                                          uint32_t events,
+                                          sd_event_io_handler_t handler);
 
     /** @brief A wrapper around the callback that can be called from sd-event
      *
@@ -140,10 +189,318 @@ class IOData : public IO, public BaseData
   public:
     IOData(const IO& base, IO::Callback&& callback);
 
+  protected:
+    Base& get_source() override;
+
     friend IO;
 };
 
 } // namespace detail
 
+/** @class StaticIO<F>
+ *  @brief An IO source whose callback type is known at compile time
+ *         The callback is stored inline in the source userdata and called
+ *         directly from the sd-event handler, without the type erased call
+ *         of IO::Callback. Use it for sources dispatched at high rates.
+ *  @note The callback can only be replaced through StaticIO::set_callback(),
+ *        IO::set_callback() throws when used on a StaticIO.
+ */
+template <typename F>
+class StaticIO : public IO
+{
+  public:
+    /** @brief Adds a new IO source handler to the Event
+     *         This type of source defaults to Enabled::On, executing the
+     *         callback for each IO epoll event observed.
+     *
+     *  @param[in] event    - The event to attach the handler
+     *  @param[in] fd       - The file descriptor producing the events
+     *  @param[in] events   - The event mask passed which determines triggers
+     *                        See epoll_ctl(2) for more info on the mask
+     *  @param[in] callback - The function executed on event dispatch
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    StaticIO(const Event& event, int fd, uint32_t events, F&& callback) :
+        IO(event, staticCallback, fd, events)
+    {
+        static_assert(std::is_invocable_v<F&, StaticIO&, int, uint32_t>,
+                      "F must be callable as void(StaticIO&, int, uint32_t)");
+        set_userdata(std::make_unique<detail::StaticIOData<F>>(
+            *this, std::move(callback)));
+    }
+
+    /** @brief Constructs a non-owning io source handler
+     *  @internal
+     *
+     *  @param[in] other - The source wrapper to copy
+     *  @param[in]       - Signifies that this new copy is non-owning
+     */
+    StaticIO(const StaticIO& other, sdeventplus::internal::NoOwn) :
+        IO(other, sdeventplus::internal::NoOwn())
+    {}
+
+    /** @brief Sets the callback
+     *
+     *  @param[in] callback - The function executed on event dispatch
+     */
+    void set_callback(F&& callback)
+    {
+        auto& current = get_userdata().callback;
+        if constexpr (std::is_move_assignable_v<F>)
+        {
+            current = std::move(callback);
+        }
+        else
+        {
+            // Capturing lambdas are not assignable, rebuild them in place
+            static_assert(std::is_nothrow_move_constructible_v<F>,
+                          "F must be move assignable or nothrow movable");
+            std::destroy_at(&current);
+            std::construct_at(&current, std::move(callback));
+        }
+    }
+
+  private:
+    detail::StaticIOData<F>& get_userdata() const
+    {
+        return static_cast<detail::StaticIOData<F>&>(Base::get_userdata());
+    }
+
+    static int staticCallback(sd_event_source* source, int fd,
+                              uint32_t revents, void* userdata)
+    {
+        return sourceCallback<F, detail::StaticIOData<F>,
+                              &detail::StaticIOData<F>::callback>(
+            "ioCallback", source, userdata, fd, revents);
+    }
+};
+
+namespace detail
+{
+
+template <typename F>
+class StaticIOData : public StaticIO<F>, public BaseData
+{
+  private:
+    F callback;
+
+  public:
+    StaticIOData(const StaticIO<F>& base, F&& callback) :
+        StaticIO<F>(base, sdeventplus::internal::NoOwn()),
+        callback(std::move(callback))
+    {}
+
+  protected:
+    Base& get_source() override
+    {
+        return *this;
+    }
+
+    friend StaticIO<F>;
+};
+
+} // namespace detail
+
+/** @class DrainIO
+ *  @brief An edge-triggered IO source handing a Reader to its callback
+ *         The file descriptor is registered with EPOLLET, so the callback is
+ *         only dispatched when new data arrives rather than on every loop
+ *         iteration while some is queued. The Reader reads until EAGAIN and
+ *         tracks whether the file descriptor was drained.
+ *
+ *         If the callback returns before the Reader drained it, for example
+ *         to bound the time spent on one peer, the source is re-armed so the
+ *         remaining data is dispatched on the next iteration instead of
+ *         waiting for more to arrive. A callback which does not read through
+ *         the Reader at all therefore behaves level-triggered. Dispatches
+ *         without EPOLLIN are never re-armed.
+ *  @note The file descriptor must be non-blocking. Changing the events mask
+ *        with set_events() has to keep EPOLLET set.
+ */
+class DrainIO : public IO
+{
+  public:
+    /** @class Reader
+     *  @brief Reads from the file descriptor of the dispatched DrainIO
+     */
+    class Reader
+    {
+      public:
+        /** @brief Creates a reader for the given file descriptor
+         *
+         *  @param[in] fd - The non-blocking file descriptor to read
+         */
+        explicit Reader(int fd) noexcept;
+
+        /** @brief Reads from the file descriptor with read(2)
+         *
+         *  @param[out] buf - The buffer receiving the data
+         *  @param[in]  len - The size of the buffer
+         *  @throws std::system_error for read errors other than EAGAIN
+         *  @return The number of bytes read, 0 once drained or at end of file
+         */
+        size_t read(void* buf, size_t len);
+
+        /** @brief Reads from the socket with recv(2)
+         *         An empty datagram is reported as the end of file.
+         *
+         *  @param[out] buf   - The buffer receiving the data
+         *  @param[in]  len   - The size of the buffer
+         *  @param[in]  flags - The flags passed to recv(2)
+         *  @throws std::system_error for recv errors other than EAGAIN
+         *  @return The number of bytes read, 0 once drained or at end of file
+         */
+        size_t recv(void* buf, size_t len, int flags = 0);
+
+        /** @brief Reads with read(2) until the file descriptor is drained
+         *
+         *  @param[out] buf     - The buffer each chunk is read into
+         *  @param[in]  len     - The size of the buffer
+         *  @param[in]  consume - Called as consume(const void*, size_t) with
+         *                        every chunk read
+         *  @throws std::system_error for read errors other than EAGAIN
+         *  @return The number of bytes read
+         */
+        template <typename F>
+        size_t drain(void* buf, size_t len, F&& consume)
+        {
+            const size_t start = bytes;
+            for (size_t r; (r = read(buf, len)) > 0;)
+            {
+                consume(static_cast<const void*>(buf), r);
+            }
+            return bytes - start;
+        }
+
+        /** @brief Gets the file descriptor read from
+         *
+         *  @return The file descriptor
+         */
+        int get_fd() const noexcept;
+
+        /** @brief Gets whether no more data can be read until the next
+         *         dispatch
+         *
+         *  @return 'true' once a read hit EAGAIN or the end of file
+         */
+        bool drained() const noexcept;
+
+        /** @brief Gets whether the end of file was reached
+         *
+         *  @return 'true' once a read returned no data
+         */
+        bool eof() const noexcept;
+
+        /** @brief Gets the number of bytes read in this dispatch
+         *
+         *  @return The number of bytes
+         */
+        size_t get_bytes() const noexcept;
+
+      private:
+        /** @brief Accounts the result of a read call
+         *
+         *  @param[in] r    - The value returned by the call
+         *  @param[in] name - The name of the call for use in errors
+         *  @return The number of bytes read
+         */
+        size_t account(ssize_t r, const char* name);
+
+        int fd;
+        bool is_drained = false;
+        bool is_eof = false;
+        size_t bytes = 0;
+    };
+
+    using Callback = fu2::unique_function<void(DrainIO& source, Reader& reader,
+                                               uint32_t revents)>;
+
+    /** @brief Adds a new edge-triggered IO source handler to the Event
+     *         This type of source defaults to Enabled::On, executing the
+     *         callback whenever new data becomes available.
+     *
+     *  @param[in] event    - The event to attach the handler
+     *  @param[in] fd       - The non-blocking file descriptor producing the
+     *                        events
+     *  @param[in] events   - The event mask passed which determines triggers,
+     *                        EPOLLET is always added
+     *  @param[in] callback - The function executed on event dispatch
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    DrainIO(const Event& event, int fd, uint32_t events, Callback&& callback);
+
+    /** @brief Constructs a non-owning drain io source handler
+     *  @internal
+     *
+     *  @param[in] other - The source wrapper to copy
+     *  @param[in]       - Signifies that this new copy is non-owning
+     */
+    DrainIO(const DrainIO& other, sdeventplus::internal::NoOwn);
+
+    /** @brief Sets the callback
+     *
+     *  @param[in] callback - The function executed on event dispatch
+     */
+    void set_callback(Callback&& callback);
+
+    /** @brief Gets the number of times the source was re-armed because a
+     *         callback returned without draining the file descriptor
+     *
+     *  @return The number of re-arms
+     */
+    uint64_t get_rearms() const;
+
+  private:
+    /** @brief Returns a reference to the source owned drain io
+     *
+     *  @return A reference to the drain io
+     */
+    detail::DrainIOData& get_userdata() const;
+
+    /** @brief Returns a reference to the callback executed for this source
+     *
+     *  @return A reference to the callback
+     */
+    Callback& get_callback();
+
+    /** @brief Makes sd-event report the data left behind by a callback
+     *         Setting the same events again is never skipped by sd-event for
+     *         edge-triggered sources, and epoll then raises a new edge.
+     *
+     *  @return 1 if re-armed, 0 if the source is disabled or was released
+     *          by the callback, or a negative errno otherwise
+     */
+    int rearm() const;
+
+    /** @brief A wrapper around the callback that can be called from sd-event
+     *
+     *  @param[in] source   - The sd_event_source associated with the call
+     *  @param[in] userdata - The provided userdata for the source
+     *  @return 0 on success or a negative errno otherwise
+     */
+    static int drainCallback(sd_event_source* source, int fd, uint32_t revents,
+                             void* userdata);
+};
+
+namespace detail
+{
+
+class DrainIOData : public DrainIO, public BaseData
+{
+  private:
+    DrainIO::Callback callback;
+    uint64_t rearms = 0;
+
+  public:
+    DrainIOData(const DrainIO& base, DrainIO::Callback&& callback);
+
+  protected:
+    Base& get_source() override;
+
+    friend DrainIO;
+};
+
+} // namespace detail
+
 } // namespace source
 } // namespace sdeventplus
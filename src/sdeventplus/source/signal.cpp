@@ -1,3 +1,4 @@
+#include <sdeventplus/internal/call.hpp>
 #include <sdeventplus/internal/cexec.hpp>
 #include <sdeventplus/internal/sdevent.hpp>
 #include <sdeventplus/source/signal.hpp>
@@ -32,7 +33,8 @@ int Signal::get_signal() const
 {
     return SDEVENTPLUS_CHECK(
         "sd_event_source_get_signal",
-        event.getSdEvent()->sd_event_source_get_signal(get()));
+        internal::call<&internal::SdEvent::sd_event_source_get_signal>(
+            event.getSdEvent(), get()));
 }
 
 detail::SignalData& Signal::get_userdata() const
@@ -48,9 +50,11 @@ Signal::Callback& Signal::get_callback()
 sd_event_source* Signal::create_source(const Event& event, int sig)
 {
     sd_event_source* source;
-    SDEVENTPLUS_CHECK("sd_event_add_signal",
-                      event.getSdEvent()->sd_event_add_signal(
-                          event.get(), &source, sig, signalCallback, nullptr));
+    SDEVENTPLUS_CHECK(
+        "sd_event_add_signal",
+        internal::call<&internal::SdEvent::sd_event_add_signal>(
+            event.getSdEvent(), event.get(), &source, sig, signalCallback,
+            nullptr));
     return source;
 }
 
@@ -65,10 +69,14 @@ namespace detail
 {
 
 SignalData::SignalData(const Signal& base, Signal::Callback&& callback) :
-    Signal(base, sdeventplus::internal::NoOwn()), BaseData(base),
-    callback(std::move(callback))
+    Signal(base, sdeventplus::internal::NoOwn()), callback(std::move(callback))
 {}
 
+Base& SignalData::get_source()
+{
+    return *this;
+}
+
 } // namespace detail
 
 } // namespace source
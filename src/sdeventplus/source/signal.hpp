@@ -110,6 +110,9 @@ class SignalData : public Signal, public BaseData
   public:
     SignalData(const Signal& base, Signal::Callback&& callback);
 
+  protected:
+    Base& get_source() override;
+
     friend Signal;
 };
 
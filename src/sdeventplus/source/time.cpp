@@ -1,10 +1,14 @@
 #include <sdeventplus/clock.hpp>
+#include <sdeventplus/internal/call.hpp>
 #include <sdeventplus/internal/cexec.hpp>
 #include <sdeventplus/internal/sdevent.hpp>
 #include <sdeventplus/source/time.hpp>
 #include <sdeventplus/types.hpp>
 
+#include <expected>
 #include <memory>
+#include <stdexcept>
+#include <system_error>
 #include <type_traits>
 #include <utility>
 
@@ -16,12 +20,20 @@ namespace source
 template <ClockId Id>
 Time<Id>::Time(const Event& event, TimePoint time, Accuracy accuracy,
                Callback&& callback) :
-    Base(event, create_source(event, time, accuracy), std::false_type())
+    Base(event, create_source(event, time, accuracy, timeCallback),
+         std::false_type())
 {
     set_userdata(
         std::make_unique<detail::TimeData<Id>>(*this, std::move(callback)));
 }
 
+template <ClockId Id>
+Time<Id>::Time(const Event& event, sd_event_time_handler_t handler,
+               TimePoint time, Accuracy accuracy) :
+    Base(event, create_source(event, time, accuracy, handler),
+         std::false_type())
+{}
+
 template <ClockId Id>
 Time<Id>::Time(const Time<Id>& other, sdeventplus::internal::NoOwn) :
     Base(other, sdeventplus::internal::NoOwn())
@@ -30,7 +42,13 @@ Time<Id>::Time(const Time<Id>& other, sdeventplus::internal::NoOwn) :
 template <ClockId Id>
 void Time<Id>::set_callback(Callback&& callback)
 {
-    get_userdata().callback = std::move(callback);
+    // Sources derived from Time keep their own userdata type
+    auto data = dynamic_cast<detail::TimeData<Id>*>(&Base::get_userdata());
+    if (data == nullptr)
+    {
+        throw std::runtime_error("Time::set_callback on a derived source");
+    }
+    data->callback = std::move(callback);
 }
 
 template <ClockId Id>
@@ -39,7 +57,8 @@ typename Time<Id>::TimePoint Time<Id>::get_time() const
     uint64_t usec;
     SDEVENTPLUS_CHECK(
         "sd_event_source_get_time",
-        event.getSdEvent()->sd_event_source_get_time(get(), &usec));
+        internal::call<&internal::SdEvent::sd_event_source_get_time>(
+            event.getSdEvent(), get(), &usec));
     return Time<Id>::TimePoint(SdEventDuration(usec));
 }
 
@@ -48,8 +67,49 @@ void Time<Id>::set_time(TimePoint time) const
 {
     SDEVENTPLUS_CHECK(
         "sd_event_source_set_time",
-        event.getSdEvent()->sd_event_source_set_time(
-            get(), SdEventDuration(time.time_since_epoch()).count()));
+        internal::call<&internal::SdEvent::sd_event_source_set_time>(
+            event.getSdEvent(), get(),
+            SdEventDuration(time.time_since_epoch()).count()));
+}
+
+template <ClockId Id>
+std::expected<void, std::error_code>
+    Time<Id>::try_set_time(TimePoint time) const noexcept
+{
+    if (get_or_null() == nullptr)
+    {
+        return internal::movedFrom();
+    }
+    return internal::expect(
+               internal::call<&internal::SdEvent::sd_event_source_set_time>(
+                   event.getSdEvent(), get_or_null(),
+                   SdEventDuration(time.time_since_epoch()).count()))
+        .transform([](int) {});
+}
+
+template <ClockId Id>
+void Time<Id>::set_time_relative(typename Clock<Id>::duration relative) const
+{
+    SDEVENTPLUS_CHECK(
+        "sd_event_source_set_time_relative",
+        internal::call<&internal::SdEvent::sd_event_source_set_time_relative>(
+            event.getSdEvent(), get(), SdEventDuration(relative).count()));
+}
+
+template <ClockId Id>
+std::expected<void, std::error_code> Time<Id>::try_set_time_relative(
+    typename Clock<Id>::duration relative) const noexcept
+{
+    if (get_or_null() == nullptr)
+    {
+        return internal::movedFrom();
+    }
+    return internal::expect(
+               internal::call<
+                   &internal::SdEvent::sd_event_source_set_time_relative>(
+                   event.getSdEvent(), get_or_null(),
+                   SdEventDuration(relative).count()))
+        .transform([](int) {});
 }
 
 template <ClockId Id>
@@ -58,16 +118,34 @@ typename Time<Id>::Accuracy Time<Id>::get_accuracy() const
     uint64_t usec;
     SDEVENTPLUS_CHECK(
         "sd_event_source_get_time_accuracy",
-        event.getSdEvent()->sd_event_source_get_time_accuracy(get(), &usec));
+        internal::call<&internal::SdEvent::sd_event_source_get_time_accuracy>(
+            event.getSdEvent(), get(), &usec));
     return SdEventDuration(usec);
 }
 
 template <ClockId Id>
 void Time<Id>::set_accuracy(Accuracy accuracy) const
 {
-    SDEVENTPLUS_CHECK("sd_event_source_set_time_accuracy",
-                      event.getSdEvent()->sd_event_source_set_time_accuracy(
-                          get(), SdEventDuration(accuracy).count()));
+    SDEVENTPLUS_CHECK(
+        "sd_event_source_set_time_accuracy",
+        internal::call<&internal::SdEvent::sd_event_source_set_time_accuracy>(
+            event.getSdEvent(), get(), SdEventDuration(accuracy).count()));
+}
+
+template <ClockId Id>
+std::expected<void, std::error_code>
+    Time<Id>::try_set_accuracy(Accuracy accuracy) const noexcept
+{
+    if (get_or_null() == nullptr)
+    {
+        return internal::movedFrom();
+    }
+    return internal::expect(
+               internal::call<
+                   &internal::SdEvent::sd_event_source_set_time_accuracy>(
+                   event.getSdEvent(), get_or_null(),
+                   SdEventDuration(accuracy).count()))
+        .transform([](int) {});
 }
 
 template <ClockId Id>
@@ -84,15 +162,17 @@ typename Time<Id>::Callback& Time<Id>::get_callback()
 
 template <ClockId Id>
 sd_event_source* Time<Id>::create_source(const Event& event, TimePoint time,
-                                         Accuracy accuracy)
+                                         Accuracy accuracy,
+                                         sd_event_time_handler_t handler)
 {
     sd_event_source* source;
     SDEVENTPLUS_CHECK(
         "sd_event_add_time",
-        event.getSdEvent()->sd_event_add_time(
-            event.get(), &source, static_cast<clockid_t>(Id),
+        internal::call<&internal::SdEvent::sd_event_add_time>(
+            event.getSdEvent(), event.get(), &source,
+            static_cast<clockid_t>(Id),
             SdEventDuration(time.time_since_epoch()).count(),
-            SdEventDuration(accuracy).count(), timeCallback, nullptr));
+            SdEventDuration(accuracy).count(), handler, nullptr));
     return source;
 }
 
@@ -116,10 +196,22 @@ namespace detail
 template <ClockId Id>
 TimeData<Id>::TimeData(const Time<Id>& base,
                        typename Time<Id>::Callback&& callback) :
-    Time<Id>(base, sdeventplus::internal::NoOwn()), BaseData(base),
+    Time<Id>(base, sdeventplus::internal::NoOwn()),
     callback(std::move(callback))
 {}
 
+template <ClockId Id>
+Base& TimeData<Id>::get_source()
+{
+    return *this;
+}
+
+template class TimeData<ClockId::RealTime>;
+template class TimeData<ClockId::Monotonic>;
+template class TimeData<ClockId::BootTime>;
+template class TimeData<ClockId::RealTimeAlarm>;
+template class TimeData<ClockId::BootTimeAlarm>;
+
 } // namespace detail
 
 } // namespace source
@@ -8,6 +8,11 @@
 #include <sdeventplus/types.hpp>
 
 #include <cstdint>
+#include <expected>
+#include <memory>
+#include <system_error>
+#include <type_traits>
+#include <utility>
 
 namespace sdeventplus
 {
@@ -18,6 +23,8 @@ namespace detail
 {
 template <ClockId Id>
 class TimeData;
+template <ClockId Id, typename F>
+class StaticTimeData;
 } // namespace detail
 
 /** @class Time<ClockId>
@@ -63,6 +70,8 @@ class Time : public Base
     /** @brief Sets the callback
      *
      *  @param[in] callback - The function executed on event dispatch
+     *  @throws std::runtime_error if the source is a StaticTime, which holds
+     *          a different callback type
      */
     void set_callback(Callback&& callback);
 
@@ -80,6 +89,35 @@ class Time : public Base
      */
     void set_time(TimePoint time) const;
 
+    /** @brief Sets the absolute time when the time source will expire
+     *         without throwing
+     *
+     *  @param[in] time - Absolute time as an std::chrono::time_point
+     *  @return Nothing, or the error reported by sd_event,
+     *          std::errc::bad_file_descriptor if the source was moved from
+     */
+    std::expected<void, std::error_code>
+        try_set_time(TimePoint time) const noexcept;
+
+    /** @brief Sets the time source to expire after the given duration
+     *         Relative to the timestamp of the current event loop iteration,
+     *         which sd-event caches, so no separate Clock::now() is needed.
+     *
+     *  @param[in] relative - Time from now as an std::chrono::duration
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    void set_time_relative(typename Clock<Id>::duration relative) const;
+
+    /** @brief Sets the time source to expire after the given duration
+     *         without throwing
+     *
+     *  @param[in] relative - Time from now as an std::chrono::duration
+     *  @return Nothing, or the error reported by sd_event,
+     *          std::errc::bad_file_descriptor if the source was moved from
+     */
+    std::expected<void, std::error_code> try_set_time_relative(
+        typename Clock<Id>::duration relative) const noexcept;
+
     /** @brief Gets the accuracy of the time source
      *
      *  @throws SdEventError for underlying sd_event errors
@@ -94,6 +132,31 @@ class Time : public Base
      */
     void set_accuracy(Accuracy accuracy) const;
 
+    /** @brief Sets the accuracy of the time source without throwing
+     *
+     *  @param[in] accuracy - Accuracy as std::chrono::duration
+     *  @return Nothing, or the error reported by sd_event,
+     *          std::errc::bad_file_descriptor if the source was moved from
+     */
+    std::expected<void, std::error_code>
+        try_set_accuracy(Accuracy accuracy) const noexcept;
+
+  protected:
+    /** @brief Creates a new time event source on the provided event loop
+     *         dispatching to the given handler. The caller is responsible
+     *         for setting the userdata expected by the handler. The
+     *         handler comes before the other arguments so a nullptr
+     *         callback never selects this constructor.
+     *
+     *  @param[in] event    - The event to attach the handler
+     *  @param[in] handler  - The sd-event handler run on event dispatch
+     *  @param[in] time     - Absolute time when the callback should be executed
+     *  @param[in] accuracy - Optional amount of error tolerable in time source
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    Time(const Event& event, sd_event_time_handler_t handler, TimePoint time,
+         Accuracy accuracy);
+
   private:
     /** @brief Returns a reference to the source owned time
      *
@@ -112,11 +175,13 @@ class Time : public Base
      *  @param[in] event    - The event to attach the handler
      *  @param[in] time     - Absolute time when the callback should be executed
      *  @param[in] accuracy - Optional amount of error tolerable in time source
+     *  @param[in] handler  - The sd-event handler run on event dispatch
      *  @throws SdEventError for underlying sd_event errors
      *  @return A new sd_event_source
      */
     static sd_event_source* create_source(const Event& event, TimePoint time,
-                                          Accuracy accuracy);
+                                          Accuracy accuracy,
+                                          sd_event_time_handler_t handler);
 
     /** @brief A wrapper around the callback that can be called from sd-event
      *
@@ -140,10 +205,122 @@ class TimeData : public Time<Id>, public BaseData
   public:
     TimeData(const Time<Id>& base, typename Time<Id>::Callback&& callback);
 
+  protected:
+    Base& get_source() override;
+
     friend Time<Id>;
 };
 
 } // namespace detail
 
+/** @class StaticTime<ClockId, F>
+ *  @brief A time source whose callback type is known at compile time
+ *         The callback is stored inline in the source userdata and called
+ *         directly from the sd-event handler, without the type erased call
+ *         of Time::Callback.
+ *  @note The callback can only be replaced through StaticTime::set_callback(),
+ *        Time::set_callback() throws when used on a StaticTime.
+ */
+template <ClockId Id, typename F>
+class StaticTime : public Time<Id>
+{
+  public:
+    using typename Time<Id>::TimePoint;
+    using typename Time<Id>::Accuracy;
+
+    /** @brief Creates a new time event source on the provided event loop
+     *         This type of source defaults to Enabled::Oneshot, and needs to be
+     *         reconfigured upon each callback.
+     *
+     *  @param[in] event    - The event to attach the handler
+     *  @param[in] time     - Absolute time when the callback should be executed
+     *  @param[in] accuracy - Optional amount of error tolerable in time source
+     *  @param[in] callback - The function executed on event dispatch
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    StaticTime(const Event& event, TimePoint time, Accuracy accuracy,
+               F&& callback) :
+        Time<Id>(event, staticCallback, time, accuracy)
+    {
+        static_assert(std::is_invocable_v<F&, StaticTime&, TimePoint>,
+                      "F must be callable as void(StaticTime&, TimePoint)");
+        this->set_userdata(std::make_unique<detail::StaticTimeData<Id, F>>(
+            *this, std::move(callback)));
+    }
+
+    /** @brief Constructs a non-owning time source handler
+     *  @internal
+     *
+     *  @param[in] other - The source wrapper to copy
+     *  @param[in]       - Signifies that this new copy is non-owning
+     */
+    StaticTime(const StaticTime& other, sdeventplus::internal::NoOwn) :
+        Time<Id>(other, sdeventplus::internal::NoOwn())
+    {}
+
+    /** @brief Sets the callback
+     *
+     *  @param[in] callback - The function executed on event dispatch
+     */
+    void set_callback(F&& callback)
+    {
+        auto& current = get_userdata().callback;
+        if constexpr (std::is_move_assignable_v<F>)
+        {
+            current = std::move(callback);
+        }
+        else
+        {
+            // Capturing lambdas are not assignable, rebuild them in place
+            static_assert(std::is_nothrow_move_constructible_v<F>,
+                          "F must be move assignable or nothrow movable");
+            std::destroy_at(&current);
+            std::construct_at(&current, std::move(callback));
+        }
+    }
+
+  private:
+    detail::StaticTimeData<Id, F>& get_userdata() const
+    {
+        return static_cast<detail::StaticTimeData<Id, F>&>(
+            Base::get_userdata());
+    }
+
+    static int staticCallback(sd_event_source* source, uint64_t usec,
+                              void* userdata)
+    {
+        return Base::sourceCallback<F, detail::StaticTimeData<Id, F>,
+                                    &detail::StaticTimeData<Id, F>::callback>(
+            "timeCallback", source, userdata,
+            TimePoint(SdEventDuration(usec)));
+    }
+};
+
+namespace detail
+{
+
+template <ClockId Id, typename F>
+class StaticTimeData : public StaticTime<Id, F>, public BaseData
+{
+  private:
+    F callback;
+
+  public:
+    StaticTimeData(const StaticTime<Id, F>& base, F&& callback) :
+        StaticTime<Id, F>(base, sdeventplus::internal::NoOwn()),
+        callback(std::move(callback))
+    {}
+
+  protected:
+    Base& get_source() override
+    {
+        return *this;
+    }
+
+    friend StaticTime<Id, F>;
+};
+
+} // namespace detail
+
 } // namespace source
 } // namespace sdeventplus
@@ -35,12 +35,24 @@ class SdEventMock : public internal::SdEvent
     MOCK_CONST_METHOD6(sd_event_add_child,
                        int(sd_event*, sd_event_source**, pid_t, int,
                            sd_event_child_handler_t, void*));
+    MOCK_CONST_METHOD6(sd_event_add_child_pidfd,
+                       int(sd_event*, sd_event_source**, int, int,
+                           sd_event_child_handler_t, void*));
+    MOCK_CONST_METHOD6(sd_event_add_inotify,
+                       int(sd_event*, sd_event_source**, const char*, uint32_t,
+                           sd_event_inotify_handler_t, void*));
+    MOCK_CONST_METHOD6(sd_event_add_inotify_fd,
+                       int(sd_event*, sd_event_source**, int, uint32_t,
+                           sd_event_inotify_handler_t, void*));
     MOCK_CONST_METHOD4(sd_event_add_defer, int(sd_event*, sd_event_source**,
                                                sd_event_handler_t, void*));
     MOCK_CONST_METHOD4(sd_event_add_post, int(sd_event*, sd_event_source**,
                                               sd_event_handler_t, void*));
     MOCK_CONST_METHOD4(sd_event_add_exit, int(sd_event*, sd_event_source**,
                                               sd_event_handler_t, void*));
+    MOCK_CONST_METHOD4(sd_event_add_memory_pressure,
+                       int(sd_event*, sd_event_source**, sd_event_handler_t,
+                           void*));
 
     MOCK_CONST_METHOD1(sd_event_prepare, int(sd_event*));
     MOCK_CONST_METHOD2(sd_event_wait, int(sd_event*, uint64_t));
@@ -58,6 +70,7 @@ class SdEventMock : public internal::SdEvent
     MOCK_CONST_METHOD1(sd_event_source_ref, sd_event_source*(sd_event_source*));
     MOCK_CONST_METHOD1(sd_event_source_unref,
                        sd_event_source*(sd_event_source*));
+    MOCK_CONST_METHOD1(sd_event_source_get_event, sd_event*(sd_event_source*));
 
     MOCK_CONST_METHOD1(sd_event_source_get_userdata, void*(sd_event_source*));
     MOCK_CONST_METHOD2(sd_event_source_set_userdata,
@@ -89,6 +102,8 @@ class SdEventMock : public internal::SdEvent
                        int(sd_event_source*, uint64_t*));
     MOCK_CONST_METHOD2(sd_event_source_set_time,
                        int(sd_event_source*, uint64_t));
+    MOCK_CONST_METHOD2(sd_event_source_set_time_relative,
+                       int(sd_event_source*, uint64_t));
     MOCK_CONST_METHOD2(sd_event_source_get_time_accuracy,
                        int(sd_event_source*, uint64_t*));
     MOCK_CONST_METHOD2(sd_event_source_set_time_accuracy,
@@ -96,6 +111,19 @@ class SdEventMock : public internal::SdEvent
     MOCK_CONST_METHOD1(sd_event_source_get_signal, int(sd_event_source*));
     MOCK_CONST_METHOD2(sd_event_source_get_child_pid,
                        int(sd_event_source*, pid_t*));
+    MOCK_CONST_METHOD1(sd_event_source_get_child_pidfd, int(sd_event_source*));
+    MOCK_CONST_METHOD1(sd_event_source_get_child_pidfd_own,
+                       int(sd_event_source*));
+    MOCK_CONST_METHOD2(sd_event_source_set_child_pidfd_own,
+                       int(sd_event_source*, int));
+    MOCK_CONST_METHOD1(sd_event_source_get_child_process_own,
+                       int(sd_event_source*));
+    MOCK_CONST_METHOD2(sd_event_source_set_child_process_own,
+                       int(sd_event_source*, int));
+    MOCK_CONST_METHOD4(sd_event_source_send_child_signal,
+                       int(sd_event_source*, int, const siginfo_t*, unsigned));
+    MOCK_CONST_METHOD2(sd_event_source_get_inotify_mask,
+                       int(sd_event_source*, uint32_t*));
     MOCK_CONST_METHOD2(sd_event_source_set_destroy_callback,
                        int(sd_event_source*, sd_event_destroy_t));
     MOCK_CONST_METHOD2(sd_event_source_get_destroy_callback,
@@ -103,6 +131,18 @@ class SdEventMock : public internal::SdEvent
     MOCK_CONST_METHOD2(sd_event_source_set_floating,
                        int(sd_event_source*, int));
     MOCK_CONST_METHOD1(sd_event_source_get_floating, int(sd_event_source*));
+    MOCK_CONST_METHOD3(sd_event_source_set_ratelimit,
+                       int(sd_event_source*, uint64_t, unsigned));
+    MOCK_CONST_METHOD3(sd_event_source_get_ratelimit,
+                       int(sd_event_source*, uint64_t*, unsigned*));
+    MOCK_CONST_METHOD1(sd_event_source_is_ratelimited,
+                       int(sd_event_source*));
+    MOCK_CONST_METHOD2(sd_event_source_set_ratelimit_expire_callback,
+                       int(sd_event_source*, sd_event_handler_t));
+    MOCK_CONST_METHOD2(sd_event_source_set_memory_pressure_type,
+                       int(sd_event_source*, const char*));
+    MOCK_CONST_METHOD3(sd_event_source_set_memory_pressure_period,
+                       int(sd_event_source*, uint64_t, uint64_t));
 };
 
 } // namespace test
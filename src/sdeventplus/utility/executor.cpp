@@ -0,0 +1,149 @@
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <sdeventplus/internal/logged_call.hpp>
+#include <sdeventplus/utility/executor.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace sdeventplus
+{
+namespace utility
+{
+
+namespace detail
+{
+
+/** @class ExecutorQueue
+ *  @brief The lock-free queue and eventfd shared between the producers and
+ *         the IO source of an Executor
+ */
+class ExecutorQueue
+{
+  public:
+    ExecutorQueue() : fd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    {
+        if (fd < 0)
+        {
+            throw std::system_error(errno, std::generic_category(),
+                                    "eventfd");
+        }
+    }
+
+    ExecutorQueue(const ExecutorQueue&) = delete;
+    ExecutorQueue& operator=(const ExecutorQueue&) = delete;
+
+    ~ExecutorQueue()
+    {
+        freeList(head.exchange(nullptr, std::memory_order_acquire));
+        close(fd);
+    }
+
+    void push(Executor::Task&& task)
+    {
+        auto node = new Node{std::move(task), nullptr};
+        node->next = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(node->next, node,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed))
+        {}
+        // Only the post making the queue non-empty needs to wake the loop,
+        // the consumer takes everything queued after it with the same batch
+        if (node->next == nullptr)
+        {
+            uint64_t val = 1;
+            while (write(fd, &val, sizeof(val)) < 0 && errno == EINTR)
+            {}
+        }
+    }
+
+    void drain()
+    {
+        // Clear the wakeup before taking the queue, any post racing with
+        // us then either lands in this batch or wakes the loop again
+        uint64_t val;
+        while (read(fd, &val, sizeof(val)) < 0 && errno == EINTR)
+        {}
+        Node* node = head.exchange(nullptr, std::memory_order_acquire);
+
+        // The stack holds the newest task first, run them in posting order
+        Node* ordered = nullptr;
+        while (node != nullptr)
+        {
+            Node* next = node->next;
+            node->next = ordered;
+            ordered = node;
+            node = next;
+        }
+        while (ordered != nullptr)
+        {
+            Node* next = ordered->next;
+            internal::loggedCall("Executor", ordered->task);
+            delete ordered;
+            ordered = next;
+        }
+    }
+
+    const int fd;
+
+  private:
+    struct Node
+    {
+        Executor::Task task;
+        Node* next;
+    };
+
+    std::atomic<Node*> head = nullptr;
+
+    static void freeList(Node* node)
+    {
+        while (node != nullptr)
+        {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+};
+
+} // namespace detail
+
+Executor::Executor(const Event& event) :
+    queue(std::make_unique<detail::ExecutorQueue>()),
+    io(event, queue->fd, EPOLLIN,
+       [queue = queue.get()](source::IO&, int, uint32_t) { queue->drain(); })
+{}
+
+Executor::Executor(Executor&& other) = default;
+Executor& Executor::operator=(Executor&& other)
+{
+    // Release the old source before the state its callback points to
+    io = std::move(other.io);
+    queue = std::move(other.queue);
+    return *this;
+}
+
+Executor::~Executor() = default;
+
+void Executor::post(Task&& task) const
+{
+    if (!queue)
+    {
+        throw std::runtime_error("Executor was moved from");
+    }
+    queue->push(std::move(task));
+}
+
+const Event& Executor::get_event() const
+{
+    return io.get_event();
+}
+
+} // namespace utility
+} // namespace sdeventplus
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <function2/function2.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <memory>
+
+namespace sdeventplus
+{
+namespace utility
+{
+
+namespace detail
+{
+class ExecutorQueue;
+} // namespace detail
+
+/** @class Executor
+ *  @brief Runs callables posted from any thread on the thread running the
+ *         event loop
+ *  @details Tasks are pushed onto a lock-free multi-producer queue and the
+ *           loop is woken through an eventfd watched by a single IO source.
+ *           Only a post onto an empty queue writes the eventfd, and every
+ *           wakeup runs all of the queued tasks in posting order, so a burst
+ *           of posts costs a single loop iteration.
+ *
+ *           The Executor must outlive every thread posting to it. Tasks
+ *           still queued when it is destroyed are dropped without running.
+ */
+class Executor
+{
+  public:
+    using Task = fu2::unique_function<void()>;
+
+    /** @brief Creates a new executor on the given event loop
+     *
+     *  @param[in] event - The event the tasks are run on
+     *  @throws std::system_error if the eventfd cannot be created
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    explicit Executor(const Event& event);
+
+    Executor(Executor&& other);
+    Executor& operator=(Executor&& other);
+    Executor(const Executor& other) = delete;
+    Executor& operator=(const Executor& other) = delete;
+    ~Executor();
+
+    /** @brief Queues a task to be run on the event loop
+     *         Safe to call from any thread, including the loop thread
+     *
+     *  @param[in] task - The task to run
+     *  @throws std::bad_alloc if the task cannot be queued
+     *  @throws std::runtime_error if the executor was moved from
+     */
+    void post(Task&& task) const;
+
+    /** @brief Gets the associated Event object
+     *
+     *  @return The Event
+     */
+    const Event& get_event() const;
+
+  private:
+    std::unique_ptr<detail::ExecutorQueue> queue;
+    source::IO io;
+};
+
+} // namespace utility
+} // namespace sdeventplus
@@ -0,0 +1,142 @@
+#include <sdeventplus/internal/destroy_guard.hpp>
+#include <sdeventplus/internal/logged_call.hpp>
+#include <sdeventplus/source/base.hpp>
+#include <sdeventplus/utility/flush_scheduler.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace sdeventplus
+{
+namespace utility
+{
+
+namespace detail
+{
+
+/** @class FlushSchedulerData
+ *  @brief The flush callbacks and the list of those requested, shared with
+ *         the Defer source of a FlushScheduler
+ */
+class FlushSchedulerData
+{
+  public:
+    struct Flush
+    {
+        FlushScheduler::Callback callback;
+        bool requested = false;
+    };
+
+    /** @brief Registered flushes, a deque so callbacks may add() more */
+    std::deque<Flush> flushes;
+    /** @brief The requested flushes in request order */
+    std::vector<FlushScheduler::Id> pending;
+    uint64_t requests = 0;
+    uint64_t flushed = 0;
+    internal::DestroyGuard guard;
+
+    /** @brief Runs the requested flushes, disabling the source once no
+     *         more are requested
+     *         A callback may destroy the FlushScheduler, which drops the
+     *         rest of the batch.
+     *
+     *  @param[in] source - The Defer source of the scheduler
+     */
+    void flush(source::EventBase& source)
+    {
+        // Requests made by the callbacks land in the next batch
+        std::vector<FlushScheduler::Id> batch;
+        batch.swap(pending);
+        for (auto id : batch)
+        {
+            flushes[id].requested = false;
+        }
+        internal::DestroyGuard::Scope scope(guard);
+        for (auto id : batch)
+        {
+            flushed++;
+            internal::loggedCall("FlushScheduler", flushes[id].callback);
+            if (scope.gone())
+            {
+                return;
+            }
+        }
+        // Keep the storage around for the next iteration
+        if (pending.empty())
+        {
+            source.set_enabled(source::Enabled::Off);
+            batch.clear();
+            pending.swap(batch);
+        }
+    }
+};
+
+} // namespace detail
+
+FlushScheduler::FlushScheduler(const Event& event, int64_t priority) :
+    data(std::make_unique<detail::FlushSchedulerData>()),
+    defer(event, [data = data.get()](source::EventBase& source) {
+        data->flush(source);
+    })
+{
+    defer.set_enabled(source::Enabled::Off);
+    defer.set_priority(priority);
+}
+
+FlushScheduler::FlushScheduler(FlushScheduler&& other) = default;
+FlushScheduler& FlushScheduler::operator=(FlushScheduler&& other)
+{
+    // Release the old source before the state its callback points to
+    defer = std::move(other.defer);
+    data = std::move(other.data);
+    return *this;
+}
+
+FlushScheduler::~FlushScheduler() = default;
+
+FlushScheduler::Id FlushScheduler::add(Callback&& callback)
+{
+    data->flushes.push_back({std::move(callback)});
+    return data->flushes.size() - 1;
+}
+
+void FlushScheduler::request(Id id)
+{
+    auto& flush = data->flushes.at(id);
+    data->requests++;
+    if (!flush.requested)
+    {
+        if (data->pending.empty())
+        {
+            defer.set_enabled(source::Enabled::On);
+        }
+        flush.requested = true;
+        data->pending.push_back(id);
+    }
+}
+
+uint64_t FlushScheduler::get_requests() const
+{
+    return data->requests;
+}
+
+uint64_t FlushScheduler::get_flushes() const
+{
+    return data->flushed;
+}
+
+uint64_t FlushScheduler::get_coalesced() const
+{
+    return data->requests - data->flushed - data->pending.size();
+}
+
+const Event& FlushScheduler::get_event() const
+{
+    return defer.get_event();
+}
+
+} // namespace utility
+} // namespace sdeventplus
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <systemd/sd-event.h>
+
+#include <function2/function2.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace sdeventplus
+{
+namespace utility
+{
+
+namespace detail
+{
+class FlushSchedulerData;
+} // namespace detail
+
+/** @class FlushScheduler
+ *  @brief Runs registered flush callbacks once at the end of each loop
+ *         iteration in which they were requested
+ *  @details Producers batching output call request() as often as they like,
+ *           and the flush callback runs once after the other sources pending
+ *           in the iteration have been dispatched. The flushes run from a
+ *           single Defer source at a low priority, so it is dispatched after
+ *           them. The source is only enabled while a flush is requested and
+ *           an idle scheduler adds no dispatches to the loop.
+ *
+ *           Requests made from a flush callback are handled in the next
+ *           loop iteration.
+ */
+class FlushScheduler
+{
+  public:
+    using Callback = fu2::unique_function<void()>;
+    /** @brief Identifies a flush callback registered with add() */
+    using Id = size_t;
+
+    /** @brief Creates a new flush scheduler on the given event loop
+     *
+     *  @param[in] event    - The event the flushes are run on
+     *  @param[in] priority - The priority of the Defer source running the
+     *                        flushes, low enough by default to run after
+     *                        regular sources
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    explicit FlushScheduler(const Event& event,
+                            int64_t priority = SD_EVENT_PRIORITY_IDLE);
+
+    FlushScheduler(FlushScheduler&& other);
+    FlushScheduler& operator=(FlushScheduler&& other);
+    FlushScheduler(const FlushScheduler& other) = delete;
+    FlushScheduler& operator=(const FlushScheduler& other) = delete;
+    ~FlushScheduler();
+
+    /** @brief Registers a new flush callback
+     *
+     *  @param[in] callback - The function flushing the batched output
+     *  @return The identifier used to request the flush
+     */
+    Id add(Callback&& callback);
+
+    /** @brief Requests the flush to run at the end of the current iteration
+     *         Further requests before it runs are coalesced into that flush.
+     *
+     *  @param[in] id - The flush returned by add()
+     *  @throws std::out_of_range if id was not returned by add()
+     */
+    void request(Id id);
+
+    /** @brief Gets the number of flush requests made so far
+     *
+     *  @return The number of calls to request()
+     */
+    uint64_t get_requests() const;
+
+    /** @brief Gets the number of flush callbacks run so far
+     *
+     *  @return The number of flushes
+     */
+    uint64_t get_flushes() const;
+
+    /** @brief Gets the number of requests which did not need a flush of
+     *         their own because one was already requested
+     *
+     *  @return The number of coalesced requests
+     */
+    uint64_t get_coalesced() const;
+
+    /** @brief Gets the associated Event object
+     *
+     *  @return The Event
+     */
+    const Event& get_event() const;
+
+  private:
+    std::unique_ptr<detail::FlushSchedulerData> data;
+    source::Defer defer;
+};
+
+} // namespace utility
+} // namespace sdeventplus
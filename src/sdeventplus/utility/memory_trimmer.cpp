@@ -0,0 +1,152 @@
+#include <sdeventplus/exception.hpp>
+#include <sdeventplus/internal/destroy_guard.hpp>
+#include <sdeventplus/internal/logged_call.hpp>
+#include <sdeventplus/utility/memory_trimmer.hpp>
+
+#include <cerrno>
+#include <cstdint>
+#include <map>
+#include <utility>
+
+namespace sdeventplus
+{
+namespace utility
+{
+
+namespace detail
+{
+
+/** @class MemoryTrimmerData
+ *  @brief The trim callbacks ordered by priority, shared with the
+ *         MemoryPressure source of a MemoryTrimmer
+ */
+class MemoryTrimmerData
+{
+  public:
+    struct Entry
+    {
+        MemoryTrimmer::Callback callback;
+        bool removed = false;
+    };
+
+    /** @brief Callbacks keyed by priority, then registration order */
+    std::map<std::pair<int64_t, MemoryTrimmer::Id>, Entry> entries;
+    MemoryTrimmer::Id next = 0;
+    uint64_t trims = 0;
+    bool trimming = false;
+    internal::DestroyGuard guard;
+
+    /** @brief Runs every registered callback in priority order
+     *         A callback may destroy the MemoryTrimmer, which ends the pass.
+     */
+    void trim()
+    {
+        if (trimming)
+        {
+            return;
+        }
+        trims++;
+        // Callbacks added while trimming run in this pass if they sort
+        // after the current one, removed ones are only erased afterwards
+        trimming = true;
+        internal::DestroyGuard::Scope scope(guard);
+        for (auto& [key, entry] : entries)
+        {
+            if (!entry.removed)
+            {
+                internal::loggedCall("MemoryTrimmer", entry.callback);
+                if (scope.gone())
+                {
+                    return;
+                }
+            }
+        }
+        trimming = false;
+        std::erase_if(entries, [](const auto& e) { return e.second.removed; });
+    }
+};
+
+} // namespace detail
+
+MemoryTrimmer::MemoryTrimmer(const Event& event) :
+    data(std::make_unique<detail::MemoryTrimmerData>())
+{
+    try
+    {
+        pressure.emplace(event, [data = data.get()](source::EventBase&) {
+            data->trim();
+        });
+    }
+    catch (const SdEventError& e)
+    {
+        const int r = e.code().value();
+        if (r != EOPNOTSUPP && r != EHOSTDOWN && r != ENOSYS)
+        {
+            throw;
+        }
+    }
+}
+
+MemoryTrimmer::MemoryTrimmer(MemoryTrimmer&& other) = default;
+MemoryTrimmer& MemoryTrimmer::operator=(MemoryTrimmer&& other)
+{
+    // Release the old source before the state its callback points to
+    pressure = std::move(other.pressure);
+    data = std::move(other.data);
+    return *this;
+}
+
+MemoryTrimmer::~MemoryTrimmer() = default;
+
+MemoryTrimmer::Id MemoryTrimmer::add(Callback&& callback, int64_t priority)
+{
+    const Id id = data->next++;
+    data->entries.emplace(std::make_pair(priority, id),
+                          detail::MemoryTrimmerData::Entry{std::move(callback)});
+    return id;
+}
+
+bool MemoryTrimmer::remove(Id id)
+{
+    for (auto it = data->entries.begin(); it != data->entries.end(); ++it)
+    {
+        if (it->first.second != id || it->second.removed)
+        {
+            continue;
+        }
+        if (data->trimming)
+        {
+            // The callback may be running, drop it once the trim is done
+            it->second.removed = true;
+        }
+        else
+        {
+            data->entries.erase(it);
+        }
+        return true;
+    }
+    return false;
+}
+
+void MemoryTrimmer::trim()
+{
+    data->trim();
+}
+
+bool MemoryTrimmer::supported() const
+{
+    return pressure.has_value();
+}
+
+uint64_t MemoryTrimmer::get_trims() const
+{
+    return data->trims;
+}
+
+const source::MemoryPressure* MemoryTrimmer::get_source() const
+{
+    return pressure ? &*pressure : nullptr;
+}
+
+} // namespace utility
+} // namespace sdeventplus
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <function2/function2.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace sdeventplus
+{
+namespace utility
+{
+
+namespace detail
+{
+class MemoryTrimmerData;
+} // namespace detail
+
+/** @class MemoryTrimmer
+ *  @brief Runs registered trim callbacks whenever the kernel reports memory
+ *         pressure on the cgroup of the process
+ *  @details Caches register a callback shrinking them with add(). On each
+ *           report of a MemoryPressure source, the callbacks run from the
+ *           lowest priority value to the highest, and in registration order
+ *           for equal priorities, so the cheapest caches to rebuild can be
+ *           dropped first.
+ *
+ *           When memory pressure sources are unavailable, because the kernel
+ *           lacks PSI, libsystemd is too old or $MEMORY_PRESSURE_WATCH turned
+ *           them off, the trimmer is still constructed: supported() returns
+ *           'false' and the callbacks only run from trim().
+ */
+class MemoryTrimmer
+{
+  public:
+    using Callback = fu2::unique_function<void()>;
+    /** @brief Identifies a trim callback registered with add() */
+    using Id = uint64_t;
+
+    /** @brief Creates a new memory trimmer watching the given event loop
+     *
+     *  @param[in] event - The event the trims are run on
+     *  @throws SdEventError for underlying sd_event errors other than
+     *          memory pressure being unsupported
+     */
+    explicit MemoryTrimmer(const Event& event);
+
+    MemoryTrimmer(MemoryTrimmer&& other);
+    MemoryTrimmer& operator=(MemoryTrimmer&& other);
+    MemoryTrimmer(const MemoryTrimmer& other) = delete;
+    MemoryTrimmer& operator=(const MemoryTrimmer& other) = delete;
+    ~MemoryTrimmer();
+
+    /** @brief Registers a new trim callback
+     *
+     *  @param[in] callback - The function shrinking a cache
+     *  @param[in] priority - Callbacks with lower values run first
+     *  @return The identifier used to remove the callback
+     */
+    Id add(Callback&& callback, int64_t priority = 0);
+
+    /** @brief Unregisters a trim callback
+     *         Safe to call from a trim callback, including for itself.
+     *
+     *  @param[in] id - The callback returned by add()
+     *  @return 'true' if the callback was removed
+     *          'false' if it was not registered
+     */
+    bool remove(Id id);
+
+    /** @brief Runs all the trim callbacks now, as on memory pressure
+     *         Does nothing when called from a trim callback.
+     */
+    void trim();
+
+    /** @brief Gets whether the trims run on memory pressure
+     *
+     *  @return 'false' if memory pressure sources are unavailable
+     */
+    bool supported() const;
+
+    /** @brief Gets the number of trims run so far
+     *
+     *  @return The number of memory pressure reports and calls to trim()
+     */
+    uint64_t get_trims() const;
+
+    /** @brief Gets the memory pressure source, to tune its type or period
+     *
+     *  @return The source, or nullptr if unsupported
+     */
+    const source::MemoryPressure* get_source() const;
+
+  private:
+    std::unique_ptr<detail::MemoryTrimmerData> data;
+    std::optional<source::MemoryPressure> pressure;
+};
+
+} // namespace utility
+} // namespace sdeventplus
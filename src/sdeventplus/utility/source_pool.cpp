@@ -0,0 +1,331 @@
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/source/base.hpp>
+#include <sdeventplus/utility/source_pool.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sdeventplus
+{
+namespace utility
+{
+
+namespace detail
+{
+
+/** @class SourcePoolData
+ *  @brief The sources of a pool, both running and parked, shared with the
+ *         callbacks of the sources
+ */
+template <typename Source>
+class SourcePoolData
+{
+  public:
+    using Callback = fu2::unique_function<void()>;
+
+    explicit SourcePoolData(size_t capacity) : capacity(capacity) {}
+
+    /** @brief Arms a parked source, or creates a new one, for the callback
+     *
+     *  @param[in] callback - The callback run by the source
+     *  @param[in] arm      - Rearms a parked source
+     *  @param[in] make     - Creates a new armed source given its callback
+     *  @return The ticket of the callback
+     */
+    template <typename Arm, typename Make>
+    PoolTicket schedule(Callback&& callback, Arm&& arm, Make&& make)
+    {
+        const size_t slot = take();
+        auto& source = slots[slot].source;
+        try
+        {
+            if (source)
+            {
+                arm(*source);
+                source->set_enabled(source::Enabled::OneShot);
+            }
+            else
+            {
+                source.emplace(make([this, slot](auto&&...) { fire(slot); }));
+            }
+        }
+        catch (...)
+        {
+            untake(slot);
+            throw;
+        }
+        auto& s = slots[slot];
+        s.callback = std::move(callback);
+        s.active = true;
+        active++;
+        return {slot, s.generation};
+    }
+
+    bool cancel(PoolTicket ticket)
+    {
+        if (ticket.slot >= slots.size())
+        {
+            return false;
+        }
+        auto& s = slots[ticket.slot];
+        if (!s.active || s.generation != ticket.generation)
+        {
+            return false;
+        }
+        // Only touch the bookkeeping once the source is off, so a failure
+        // leaves the callback armed and its ticket valid
+        s.source->set_enabled(source::Enabled::Off);
+        release(ticket.slot);
+        return true;
+    }
+
+    /** @brief Releases the idle sources above the capacity */
+    void trim()
+    {
+        while (parked.size() > capacity)
+        {
+            drop(parked.back());
+            parked.pop_back();
+        }
+    }
+
+    size_t capacity;
+    size_t active = 0;
+    /** @brief Slots holding an idle source */
+    std::vector<size_t> parked;
+
+  private:
+    struct Slot
+    {
+        std::optional<Source> source;
+        Callback callback;
+        uint64_t generation = 0;
+        bool active = false;
+    };
+
+    /** @brief All slots, a deque so sources never move once created */
+    std::deque<Slot> slots;
+    /** @brief Slots without a source */
+    std::vector<size_t> empty;
+
+    size_t take()
+    {
+        if (!parked.empty())
+        {
+            const size_t slot = parked.back();
+            parked.pop_back();
+            return slot;
+        }
+        if (!empty.empty())
+        {
+            const size_t slot = empty.back();
+            empty.pop_back();
+            return slot;
+        }
+        slots.emplace_back();
+        return slots.size() - 1;
+    }
+
+    void untake(size_t slot)
+    {
+        if (slots[slot].source)
+        {
+            parked.push_back(slot);
+        }
+        else
+        {
+            empty.push_back(slot);
+        }
+    }
+
+    void drop(size_t slot)
+    {
+        slots[slot].source.reset();
+        empty.push_back(slot);
+    }
+
+    void release(size_t slot)
+    {
+        auto& s = slots[slot];
+        s.callback = nullptr;
+        s.active = false;
+        s.generation++;
+        active--;
+        if (parked.size() < capacity)
+        {
+            parked.push_back(slot);
+        }
+        else
+        {
+            // sd-event defers freeing a source until its dispatch finished
+            drop(slot);
+        }
+    }
+
+    void fire(size_t slot)
+    {
+        // Park the source first so the callback can schedule on it again
+        Callback callback = std::move(slots[slot].callback);
+        release(slot);
+        callback();
+    }
+};
+
+/** @brief Returns the data of a pool
+ *
+ *  @param[in] data - The data owned by the pool
+ *  @param[in] name - The pool type named in the error
+ *  @throws std::runtime_error if the pool was moved from
+ */
+template <typename Source>
+SourcePoolData<Source>&
+    checked(const std::unique_ptr<SourcePoolData<Source>>& data,
+            const char* name)
+{
+    if (!data)
+    {
+        throw std::runtime_error(std::string(name) + " was moved from");
+    }
+    return *data;
+}
+
+} // namespace detail
+
+template <ClockId Id>
+TimePool<Id>::TimePool(const Event& event, size_t capacity) :
+    event(event),
+    data(std::make_unique<detail::SourcePoolData<source::Time<Id>>>(capacity))
+{}
+
+template <ClockId Id>
+TimePool<Id>::TimePool(TimePool&& other) = default;
+template <ClockId Id>
+TimePool<Id>& TimePool<Id>::operator=(TimePool&& other) = default;
+template <ClockId Id>
+TimePool<Id>::~TimePool() = default;
+
+template <ClockId Id>
+PoolTicket TimePool<Id>::schedule(TimePoint time, Accuracy accuracy,
+                                  Callback&& callback)
+{
+    return detail::checked(data, "TimePool").schedule(
+        std::move(callback),
+        [&](source::Time<Id>& source) {
+            source.set_time(time);
+            source.set_accuracy(accuracy);
+        },
+        [&](auto&& fire) {
+            return source::Time<Id>(event, time, accuracy, std::move(fire));
+        });
+}
+
+template <ClockId Id>
+PoolTicket TimePool<Id>::schedule_after(Duration relative, Accuracy accuracy,
+                                        Callback&& callback)
+{
+    return detail::checked(data, "TimePool").schedule(
+        std::move(callback),
+        [&](source::Time<Id>& source) {
+            source.set_time_relative(relative);
+            source.set_accuracy(accuracy);
+        },
+        [&](auto&& fire) {
+            return source::Time<Id>(event, Clock<Id>(event).now() + relative,
+                                    accuracy, std::move(fire));
+        });
+}
+
+template <ClockId Id>
+bool TimePool<Id>::cancel(PoolTicket ticket)
+{
+    return detail::checked(data, "TimePool").cancel(ticket);
+}
+
+template <ClockId Id>
+size_t TimePool<Id>::active() const
+{
+    return detail::checked(data, "TimePool").active;
+}
+
+template <ClockId Id>
+size_t TimePool<Id>::parked() const
+{
+    return detail::checked(data, "TimePool").parked.size();
+}
+
+template <ClockId Id>
+size_t TimePool<Id>::get_capacity() const
+{
+    return detail::checked(data, "TimePool").capacity;
+}
+
+template <ClockId Id>
+void TimePool<Id>::set_capacity(size_t capacity)
+{
+    auto& d = detail::checked(data, "TimePool");
+    d.capacity = capacity;
+    d.trim();
+}
+
+template class TimePool<ClockId::RealTime>;
+template class TimePool<ClockId::Monotonic>;
+template class TimePool<ClockId::BootTime>;
+template class TimePool<ClockId::RealTimeAlarm>;
+template class TimePool<ClockId::BootTimeAlarm>;
+
+DeferPool::DeferPool(const Event& event, size_t capacity) :
+    event(event),
+    data(std::make_unique<detail::SourcePoolData<source::Defer>>(capacity))
+{}
+
+DeferPool::DeferPool(DeferPool&& other) = default;
+DeferPool& DeferPool::operator=(DeferPool&& other) = default;
+DeferPool::~DeferPool() = default;
+
+PoolTicket DeferPool::schedule(Callback&& callback)
+{
+    return detail::checked(data, "DeferPool").schedule(
+        std::move(callback), [](source::Defer&) {},
+        [&](auto&& fire) {
+            source::Defer defer(event, std::move(fire));
+            defer.set_enabled(source::Enabled::OneShot);
+            return defer;
+        });
+}
+
+bool DeferPool::cancel(PoolTicket ticket)
+{
+    return detail::checked(data, "DeferPool").cancel(ticket);
+}
+
+size_t DeferPool::active() const
+{
+    return detail::checked(data, "DeferPool").active;
+}
+
+size_t DeferPool::parked() const
+{
+    return detail::checked(data, "DeferPool").parked.size();
+}
+
+size_t DeferPool::get_capacity() const
+{
+    return detail::checked(data, "DeferPool").capacity;
+}
+
+void DeferPool::set_capacity(size_t capacity)
+{
+    auto& d = detail::checked(data, "DeferPool");
+    d.capacity = capacity;
+    d.trim();
+}
+
+} // namespace utility
+} // namespace sdeventplus
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <function2/function2.hpp>
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+#include <sdeventplus/source/time.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace sdeventplus
+{
+namespace utility
+{
+
+namespace detail
+{
+template <typename Source>
+class SourcePoolData;
+} // namespace detail
+
+/** @brief Identifies a callback scheduled on a TimePool or DeferPool
+ *         The generation tells apart successive uses of the same source, so
+ *         a stale ticket never cancels a later callback.
+ */
+struct PoolTicket
+{
+    size_t slot;
+    uint64_t generation;
+};
+
+/** @class TimePool<Id>
+ *  @brief Runs one-shot time callbacks on recycled time sources
+ *  @details Creating a source::Time for every timeout costs an
+ *           sd_event_add_time() and a source teardown each time. The pool
+ *           instead parks the source once its callback ran or was cancelled,
+ *           disabled, and rearms it with set_time() for the next callback.
+ *           At most capacity idle sources are kept around, the others are
+ *           released to sd-event.
+ *
+ *           Every method but the move operations throws std::runtime_error
+ *           when called on a moved from pool.
+ */
+template <ClockId Id>
+class TimePool
+{
+  public:
+    using Callback = fu2::unique_function<void()>;
+    using TimePoint = typename source::Time<Id>::TimePoint;
+    using Accuracy = typename source::Time<Id>::Accuracy;
+    using Duration = typename Clock<Id>::duration;
+
+    /** @brief Creates a new, empty time source pool
+     *
+     *  @param[in] event    - The event the sources are attached to
+     *  @param[in] capacity - The maximum number of idle sources kept
+     */
+    explicit TimePool(const Event& event, size_t capacity = 64);
+
+    TimePool(TimePool&& other);
+    TimePool& operator=(TimePool&& other);
+    TimePool(const TimePool& other) = delete;
+    TimePool& operator=(const TimePool& other) = delete;
+    ~TimePool();
+
+    /** @brief Runs the callback once the absolute time is reached
+     *
+     *  @param[in] time     - Absolute time when the callback should be run
+     *  @param[in] accuracy - Amount of error tolerable in the expiration
+     *  @param[in] callback - The function run on expiration
+     *  @throws SdEventError for underlying sd_event errors
+     *  @return The ticket used to cancel the callback
+     */
+    PoolTicket schedule(TimePoint time, Accuracy accuracy, Callback&& callback);
+
+    /** @brief Runs the callback once the duration elapsed, relative to the
+     *         timestamp of the current event loop iteration
+     *
+     *  @param[in] relative - Time from now until the callback should be run
+     *  @param[in] accuracy - Amount of error tolerable in the expiration
+     *  @param[in] callback - The function run on expiration
+     *  @throws SdEventError for underlying sd_event errors
+     *  @return The ticket used to cancel the callback
+     */
+    PoolTicket schedule_after(Duration relative, Accuracy accuracy,
+                              Callback&& callback);
+
+    /** @brief Cancels a callback which has not run yet
+     *
+     *  @param[in] ticket - The ticket returned when scheduling
+     *  @throws SdEventError for underlying sd_event errors, the callback then
+     *          stays scheduled
+     *  @return 'true' if the callback was cancelled
+     *          'false' if it already ran or was cancelled before
+     */
+    bool cancel(PoolTicket ticket);
+
+    /** @brief Gets the number of callbacks waiting to run */
+    size_t active() const;
+
+    /** @brief Gets the number of idle sources ready for reuse */
+    size_t parked() const;
+
+    /** @brief Gets the maximum number of idle sources kept */
+    size_t get_capacity() const;
+
+    /** @brief Sets the maximum number of idle sources kept
+     *         Idle sources above the new capacity are released.
+     *
+     *  @param[in] capacity - The new capacity
+     */
+    void set_capacity(size_t capacity);
+
+  private:
+    Event event;
+    std::unique_ptr<detail::SourcePoolData<source::Time<Id>>> data;
+};
+
+/** @class DeferPool
+ *  @brief Runs one-shot deferred callbacks on recycled defer sources
+ *  @details Same as TimePool for callbacks run on the next loop iteration.
+ */
+class DeferPool
+{
+  public:
+    using Callback = fu2::unique_function<void()>;
+
+    /** @brief Creates a new, empty defer source pool
+     *
+     *  @param[in] event    - The event the sources are attached to
+     *  @param[in] capacity - The maximum number of idle sources kept
+     */
+    explicit DeferPool(const Event& event, size_t capacity = 64);
+
+    DeferPool(DeferPool&& other);
+    DeferPool& operator=(DeferPool&& other);
+    DeferPool(const DeferPool& other) = delete;
+    DeferPool& operator=(const DeferPool& other) = delete;
+    ~DeferPool();
+
+    /** @brief Runs the callback once on a following loop iteration
+     *
+     *  @param[in] callback - The function to run
+     *  @throws SdEventError for underlying sd_event errors
+     *  @return The ticket used to cancel the callback
+     */
+    PoolTicket schedule(Callback&& callback);
+
+    /** @brief Cancels a callback which has not run yet
+     *
+     *  @param[in] ticket - The ticket returned when scheduling
+     *  @throws SdEventError for underlying sd_event errors, the callback then
+     *          stays scheduled
+     *  @return 'true' if the callback was cancelled
+     *          'false' if it already ran or was cancelled before
+     */
+    bool cancel(PoolTicket ticket);
+
+    /** @brief Gets the number of callbacks waiting to run */
+    size_t active() const;
+
+    /** @brief Gets the number of idle sources ready for reuse */
+    size_t parked() const;
+
+    /** @brief Gets the maximum number of idle sources kept */
+    size_t get_capacity() const;
+
+    /** @brief Sets the maximum number of idle sources kept
+     *         Idle sources above the new capacity are released.
+     *
+     *  @param[in] capacity - The new capacity
+     */
+    void set_capacity(size_t capacity);
+
+  private:
+    Event event;
+    std::unique_ptr<detail::SourcePoolData<source::Defer>> data;
+};
+
+} // namespace utility
+} // namespace sdeventplus
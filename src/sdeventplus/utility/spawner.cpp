@@ -0,0 +1,167 @@
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <sdeventplus/internal/logged_call.hpp>
+#include <sdeventplus/source/child.hpp>
+#include <sdeventplus/utility/spawner.hpp>
+
+#include <cerrno>
+#include <cstdint>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+
+extern char** environ;
+
+namespace sdeventplus
+{
+namespace utility
+{
+
+namespace detail
+{
+
+/** @class SpawnerData
+ *  @brief The running children of a Spawner, shared with their Child sources
+ */
+class SpawnerData
+{
+  public:
+    struct Running
+    {
+        source::Child child;
+        Spawner::Callback callback;
+    };
+
+    Event event;
+    std::unordered_map<pid_t, Running> children;
+    uint64_t spawned = 0;
+
+    explicit SpawnerData(const Event& event) : event(event) {}
+
+    void exited(pid_t pid, const siginfo_t* si)
+    {
+        auto it = children.find(pid);
+        auto callback = std::move(it->second.callback);
+        // sd-event keeps the source around until the dispatch is done and
+        // reaps the child once the callback returns
+        children.erase(it);
+        internal::loggedCall("Spawner", callback, pid, si);
+    }
+};
+
+/** @brief Launches a process and opens a pidfd for it
+ *         The pid can not be recycled before the pidfd is opened, as the
+ *         child is only reaped through its source.
+ *
+ *  @param[in] argv    - The nullptr terminated arguments of the program
+ *  @param[in] actions - The optional file actions applied in the child
+ *  @param[out] pidfd  - The pidfd of the child
+ *  @throws std::system_error if the process could not be launched
+ *  @return The pid of the child
+ */
+static pid_t spawnPidFd(const char* const argv[],
+                        const posix_spawn_file_actions_t* actions, int& pidfd)
+{
+    // SIGCHLD is blocked for sd-event, which children should not inherit
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    sigset_t mask;
+    sigemptyset(&mask);
+    posix_spawnattr_setsigmask(&attr, &mask);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK);
+    pid_t pid;
+    int r = posix_spawnp(&pid, argv[0], actions, &attr,
+                         const_cast<char* const*>(argv), environ);
+    posix_spawnattr_destroy(&attr);
+    if (r != 0)
+    {
+        throw std::system_error(r, std::generic_category(), "posix_spawnp");
+    }
+
+    pidfd = syscall(SYS_pidfd_open, pid, 0);
+    if (pidfd < 0)
+    {
+        r = errno;
+        ::kill(pid, SIGKILL);
+        waitpid(pid, nullptr, 0);
+        throw std::system_error(r, std::generic_category(), "pidfd_open");
+    }
+    return pid;
+}
+
+} // namespace detail
+
+Spawner::Spawner(const Event& event) :
+    data(std::make_unique<detail::SpawnerData>(event))
+{}
+
+Spawner::Spawner(Spawner&& other) = default;
+Spawner& Spawner::operator=(Spawner&& other) = default;
+Spawner::~Spawner() = default;
+
+pid_t Spawner::spawn(const char* const argv[], Callback&& callback,
+                     const posix_spawn_file_actions_t* actions)
+{
+    int pidfd;
+    const pid_t pid = detail::spawnPidFd(argv, actions, pidfd);
+    bool owned = false;
+    try
+    {
+        source::Child child(
+            data->event, source::PidFd{pidfd}, WEXITED,
+            [data = data.get(), pid](source::Child&, const siginfo_t* si) {
+                data->exited(pid, si);
+            });
+        child.set_process_own(true);
+        child.set_pidfd_own(true);
+        owned = true;
+        data->children.emplace(
+            pid, detail::SpawnerData::Running{std::move(child),
+                                              std::move(callback)});
+    }
+    catch (...)
+    {
+        // A source that was created is gone by now, taking the pidfd along
+        // if it owned it
+        if (!owned)
+        {
+            syscall(SYS_pidfd_send_signal, pidfd, SIGKILL, nullptr, 0);
+            waitpid(pid, nullptr, 0);
+            close(pidfd);
+        }
+        throw;
+    }
+    data->spawned++;
+    return pid;
+}
+
+bool Spawner::kill(pid_t pid, int sig)
+{
+    auto it = data->children.find(pid);
+    if (it == data->children.end())
+    {
+        return false;
+    }
+    it->second.child.send_signal(sig);
+    return true;
+}
+
+size_t Spawner::get_running() const
+{
+    return data->children.size();
+}
+
+uint64_t Spawner::get_spawned() const
+{
+    return data->spawned;
+}
+
+const Event& Spawner::get_event() const
+{
+    return data->event;
+}
+
+} // namespace utility
+} // namespace sdeventplus
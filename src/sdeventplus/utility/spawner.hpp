@@ -0,0 +1,104 @@
+#pragma once
+
+#include <signal.h>
+#include <spawn.h>
+#include <sys/types.h>
+
+#include <function2/function2.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace sdeventplus
+{
+namespace utility
+{
+
+namespace detail
+{
+class SpawnerData;
+} // namespace detail
+
+/** @class Spawner
+ *  @brief Launches child processes and watches each of them through a pidfd
+ *         backed Child source
+ *  @details Every process is started with posix_spawnp(3), which avoids
+ *           copying the page tables of the parent, and is tracked by its
+ *           pidfd from then on. sd-event waits on the pidfd directly rather
+ *           than scanning children with waitid(2) on every SIGCHLD, and
+ *           signals sent with kill() can never reach a process which reused
+ *           the pid.
+ *
+ *           Like other Child sources, SIGCHLD must be blocked in all the
+ *           threads of the process. The children start with an empty signal
+ *           mask. Children still running when the Spawner is destroyed are
+ *           sent SIGKILL and reaped.
+ */
+class Spawner
+{
+  public:
+    /** @brief Executed once the child exited, see waitid(2) for siginfo */
+    using Callback = fu2::unique_function<void(pid_t pid, const siginfo_t* si)>;
+
+    /** @brief Creates a new spawner on the given event loop
+     *
+     *  @param[in] event - The event the children are watched on
+     */
+    explicit Spawner(const Event& event);
+
+    Spawner(Spawner&& other);
+    Spawner& operator=(Spawner&& other);
+    Spawner(const Spawner& other) = delete;
+    Spawner& operator=(const Spawner& other) = delete;
+    ~Spawner();
+
+    /** @brief Launches a new child process
+     *
+     *  @param[in] argv     - The nullptr terminated arguments of the program,
+     *                        argv[0] is looked up in $PATH
+     *  @param[in] callback - The function executed once the child exited
+     *  @param[in] actions  - The optional file actions applied in the child
+     *  @throws std::system_error if the process could not be launched
+     *  @throws SdEventError for underlying sd_event errors, after killing
+     *          the child
+     *  @return The pid of the child
+     */
+    pid_t spawn(const char* const argv[], Callback&& callback,
+                const posix_spawn_file_actions_t* actions = nullptr);
+
+    /** @brief Sends a signal to a running child through its pidfd
+     *
+     *  @param[in] pid - The child returned by spawn()
+     *  @param[in] sig - The signal to send
+     *  @throws SdEventError for underlying sd_event errors
+     *  @return 'true' if the signal was sent
+     *          'false' if the child already exited
+     */
+    bool kill(pid_t pid, int sig = SIGTERM);
+
+    /** @brief Gets the number of children which did not exit yet
+     *
+     *  @return The number of running children
+     */
+    size_t get_running() const;
+
+    /** @brief Gets the number of children launched so far
+     *
+     *  @return The number of successful calls to spawn()
+     */
+    uint64_t get_spawned() const;
+
+    /** @brief Gets the associated Event object
+     *
+     *  @return The Event
+     */
+    const Event& get_event() const;
+
+  private:
+    std::unique_ptr<detail::SpawnerData> data;
+};
+
+} // namespace utility
+} // namespace sdeventplus
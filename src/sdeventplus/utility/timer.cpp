@@ -2,8 +2,11 @@
 #include <sdeventplus/types.hpp>
 #include <sdeventplus/utility/timer.hpp>
 
+#include <expected>
 #include <memory>
+#include <optional>
 #include <stdexcept>
+#include <system_error>
 #include <utility>
 
 namespace sdeventplus
@@ -25,8 +28,9 @@ Timer<Id>::Timer(const Event& event, Callback&& callback,
     userdata = timerData.get();
     timerData->userdata = timerData.get();
     auto cb = [timerData = std::move(timerData)](
-                  source::Time<Id>&, typename source::Time<Id>::TimePoint) {
-        timerData->internalCallback();
+                  source::Time<Id>&,
+                  typename source::Time<Id>::TimePoint deadline) {
+        timerData->internalCallback(deadline);
     };
     timeSource.set_callback(std::move(cb));
     setEnabled(interval.has_value());
@@ -106,13 +110,58 @@ void Timer<Id>::setEnabled(bool enabled)
     }
     timeSource.set_enabled(
         enabled ? source::Enabled::On : source::Enabled::Off);
+    userdata->enabled = enabled;
+}
+
+template <ClockId Id>
+std::expected<void, std::error_code>
+    Timer<Id>::trySetEnabled(bool enabled) noexcept
+{
+    if (enabled && !userdata->initialized)
+    {
+        return std::unexpected(
+            std::make_error_code(std::errc::invalid_argument));
+    }
+    return timeSource
+        .try_set_enabled(enabled ? source::Enabled::On : source::Enabled::Off)
+        .transform([&]() { userdata->enabled = enabled; });
 }
 
 template <ClockId Id>
 void Timer<Id>::setRemaining(Duration remaining)
 {
-    timeSource.set_time(userdata->clock.now() + remaining);
+    // sd_event_now() is cached for each loop iteration, so restarts within
+    // an iteration compute the same expiration
+    const auto expiration = userdata->clock.now() + remaining;
+    if (userdata->expiration != expiration)
+    {
+        timeSource.set_time(expiration);
+        userdata->expiration = expiration;
+    }
+    userdata->initialized = true;
+}
+
+template <ClockId Id>
+std::expected<void, std::error_code>
+    Timer<Id>::trySetRemaining(Duration remaining) noexcept
+{
+    auto now = userdata->clock.try_now();
+    if (!now)
+    {
+        return std::unexpected(now.error());
+    }
+    const auto expiration = *now + remaining;
+    if (userdata->expiration != expiration)
+    {
+        auto ret = timeSource.try_set_time(expiration);
+        if (!ret)
+        {
+            return ret;
+        }
+        userdata->expiration = expiration;
+    }
     userdata->initialized = true;
+    return {};
 }
 
 template <ClockId Id>
@@ -143,7 +192,25 @@ void Timer<Id>::restart(std::optional<Duration> interval)
     {
         resetRemaining();
     }
-    setEnabled(userdata->interval.has_value());
+    updateEnabled(userdata->interval.has_value());
+}
+
+template <ClockId Id>
+std::expected<void, std::error_code>
+    Timer<Id>::tryRestart(std::optional<Duration> interval) noexcept
+{
+    clearExpired();
+    userdata->initialized = false;
+    setInterval(interval);
+    if (userdata->interval)
+    {
+        auto ret = trySetRemaining(*userdata->interval);
+        if (!ret)
+        {
+            return ret;
+        }
+    }
+    return tryUpdateEnabled(userdata->interval.has_value());
 }
 
 template <ClockId Id>
@@ -153,17 +220,79 @@ void Timer<Id>::restartOnce(Duration remaining)
     userdata->initialized = false;
     setInterval(std::nullopt);
     setRemaining(remaining);
-    setEnabled(true);
+    updateEnabled(true);
+}
+
+template <ClockId Id>
+std::expected<void, std::error_code>
+    Timer<Id>::tryRestartOnce(Duration remaining) noexcept
+{
+    clearExpired();
+    userdata->initialized = false;
+    setInterval(std::nullopt);
+    auto ret = trySetRemaining(remaining);
+    if (!ret)
+    {
+        return ret;
+    }
+    return tryUpdateEnabled(true);
+}
+
+template <ClockId Id>
+void Timer<Id>::setFixedRate(std::optional<CatchUp> catchUp)
+{
+    userdata->fixedRate = catchUp;
+}
+
+template <ClockId Id>
+std::optional<CatchUp> Timer<Id>::getFixedRate() const
+{
+    return userdata->fixedRate;
+}
+
+template <ClockId Id>
+uint64_t Timer<Id>::getMissed() const
+{
+    return userdata->missed;
+}
+
+template <ClockId Id>
+void Timer<Id>::updateEnabled(bool enabled)
+{
+    if (userdata->enabled != enabled)
+    {
+        setEnabled(enabled);
+    }
 }
 
 template <ClockId Id>
-void Timer<Id>::internalCallback()
+std::expected<void, std::error_code>
+    Timer<Id>::tryUpdateEnabled(bool enabled) noexcept
+{
+    if (userdata->enabled != enabled)
+    {
+        return trySetEnabled(enabled);
+    }
+    return {};
+}
+
+template <ClockId Id>
+void Timer<Id>::internalCallback(
+    typename source::Time<Id>::TimePoint deadline)
 {
     userdata->expired = true;
     userdata->initialized = false;
-    if (userdata->interval)
+    userdata->missed = 0;
+    if (userdata->interval && userdata->fixedRate)
     {
-        resetRemaining();
+        rearmFixedRate(deadline);
+    }
+    else if (userdata->interval)
+    {
+        // The next expiration is relative to the timestamp of this iteration
+        timeSource.set_time_relative(*userdata->interval);
+        userdata->expiration.reset();
+        userdata->initialized = true;
     }
     else
     {
@@ -176,6 +305,27 @@ void Timer<Id>::internalCallback()
     }
 }
 
+template <ClockId Id>
+void Timer<Id>::rearmFixedRate(typename source::Time<Id>::TimePoint deadline)
+{
+    const auto interval = *userdata->interval;
+    auto expiration = deadline + interval;
+    const auto now = userdata->clock.now();
+    if (expiration < now && *userdata->fixedRate != CatchUp::Burst)
+    {
+        // Continue with the first expiration which is not in the past
+        const uint64_t behind = (now - deadline - Duration{1}) / interval;
+        expiration = deadline + interval * (behind + 1);
+        if (*userdata->fixedRate == CatchUp::Report)
+        {
+            userdata->missed = behind;
+        }
+    }
+    timeSource.set_time(expiration);
+    userdata->expiration = expiration;
+    userdata->initialized = true;
+}
+
 template class Timer<ClockId::RealTime>;
 template class Timer<ClockId::Monotonic>;
 template class Timer<ClockId::BootTime>;
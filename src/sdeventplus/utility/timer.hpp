@@ -7,7 +7,10 @@
 #include <sdeventplus/types.hpp>
 
 #include <chrono>
+#include <cstdint>
+#include <expected>
 #include <optional>
+#include <system_error>
 
 namespace sdeventplus
 {
@@ -20,6 +23,17 @@ template <ClockId Id>
 class TimerData;
 } // namespace detail
 
+/** @brief How a fixed rate timer handles expirations it fell behind on */
+enum class CatchUp
+{
+    /** @brief Drop the missed expirations and continue on the schedule */
+    Skip,
+    /** @brief Run the callback back to back until the timer caught up */
+    Burst,
+    /** @brief Like Skip, with the count available from Timer::getMissed() */
+    Report,
+};
+
 /** @class Timer<Id>
  *  @brief A simple, repeating timer around an sd_event time source
  *  @details Adds a timer to the SdEvent loop that runs a user defined callback
@@ -141,14 +155,34 @@ class Timer
      */
     void setEnabled(bool enabled);
 
+    /** @brief Sets whether or not the timer is running without throwing
+     *
+     *  @param[in] enabled - Should the timer be enabled or disabled
+     *  @return Nothing, std::errc::invalid_argument if the timer has not
+     *          been initialized, or the error reported by sd_event
+     */
+    std::expected<void, std::error_code> trySetEnabled(bool enabled) noexcept;
+
     /** @brief Sets the amount of time left until the timer expires.
      *         This does not affect the interval used for subsequent runs.
+     *         Restarting the timer to the same expiration, like a watchdog
+     *         kicked several times in one loop iteration, leaves the time
+     *         source untouched.
      *
      *  @param[in] remaining - The new amount of time left on the timer
      *  @throws SdEventError for underlying sd_event errors
      */
     void setRemaining(Duration remaining);
 
+    /** @brief Sets the amount of time left until the timer expires
+     *         without throwing
+     *
+     *  @param[in] remaining - The new amount of time left on the timer
+     *  @return Nothing, or the error reported by sd_event
+     */
+    std::expected<void, std::error_code>
+        trySetRemaining(Duration remaining) noexcept;
+
     /** @brief Resets the amount of time left to the interval of the timer.
      *
      *  @throws SdEventError for underlying sd_event errors
@@ -175,16 +209,59 @@ class Timer
      */
     void restart(std::optional<Duration> interval);
 
+    /** @brief Restarts the timer like restart() without throwing
+     *
+     *  @param[in] interval - The new interval for the timer
+     *  @return Nothing, or the error reported by sd_event
+     */
+    std::expected<void, std::error_code>
+        tryRestart(std::optional<Duration> interval) noexcept;
+
     /** @brief Restarts the timer as though it has been completely
      *         re-initialized. Expired status is reset, interval is removed,
      *         time remaining is set to the new remaining, and the timer is
-     *         enabled as a one shot.
+     *         enabled as a one shot. Restarting a running timer, or to the
+     *         same expiration, skips the calls into sd-event which would
+     *         not change anything.
      *
      *  @param[in] interval - The new interval for the timer
      *  @throws SdEventError for underlying sd_event errors
      */
     void restartOnce(Duration remaining);
 
+    /** @brief Restarts the timer like restartOnce() without throwing
+     *
+     *  @param[in] remaining - The new amount of time left on the timer
+     *  @return Nothing, or the error reported by sd_event
+     */
+    std::expected<void, std::error_code>
+        tryRestartOnce(Duration remaining) noexcept;
+
+    /** @brief Sets whether or not a periodic timer runs at a fixed rate
+     *         By default the next expiration is one interval after the
+     *         callback was dispatched, so dispatch latency accumulates as
+     *         phase drift. At a fixed rate it is one interval after the
+     *         previous expiration was due instead, keeping the timer locked
+     *         to its original phase.
+     *
+     *  @param[in] catchUp - How missed expirations are handled, or
+     *                       std::nullopt to schedule from the dispatch time
+     */
+    void setFixedRate(std::optional<CatchUp> catchUp);
+
+    /** @brief Gets the fixed rate policy of the timer
+     *
+     *  @return The catch up policy, std::nullopt if not at a fixed rate
+     */
+    std::optional<CatchUp> getFixedRate() const;
+
+    /** @brief Gets the number of expirations skipped before the current one
+     *         Only counted with CatchUp::Report, for use from the callback.
+     *
+     *  @return The number of missed expirations
+     */
+    uint64_t getMissed() const;
+
   protected:
     /** @brief Reference to the heap allocated Timer.
      *         Lifetime and ownership is managed by the timeSource
@@ -196,7 +273,21 @@ class Timer
     /** @brief Used as a helper to run our user defined callback on the
      *         timeSource
      */
-    void internalCallback();
+    void internalCallback(typename source::Time<Id>::TimePoint deadline);
+
+    /** @brief Schedules the expiration following the one due at deadline
+     *         for a fixed rate timer
+     */
+    void rearmFixedRate(typename source::Time<Id>::TimePoint deadline);
+
+    /** @brief Sets whether or not the timer is running, unless it is known
+     *         to be in that state already
+     */
+    void updateEnabled(bool enabled);
+
+    /** @brief Same as updateEnabled() without throwing */
+    std::expected<void, std::error_code>
+        tryUpdateEnabled(bool enabled) noexcept;
 
     friend detail::TimerData<Id>;
 };
@@ -218,6 +309,14 @@ class TimerData : public Timer<Id>
     Clock<Id> clock;
     /** @brief Interval between each timer expiration */
     std::optional<typename Timer<Id>::Duration> interval;
+    /** @brief The expiration last set on the time source, if known */
+    std::optional<typename source::Time<Id>::TimePoint> expiration;
+    /** @brief The enabled state last set on the time source, if known */
+    std::optional<bool> enabled;
+    /** @brief Catch up policy when running at a fixed rate */
+    std::optional<CatchUp> fixedRate;
+    /** @brief Expirations reported as missed before the current one */
+    uint64_t missed = 0;
 
   public:
     TimerData(const Timer<Id>& base, typename Timer<Id>::Callback&& callback,
@@ -0,0 +1,192 @@
+#include <sdeventplus/internal/logged_call.hpp>
+#include <sdeventplus/source/base.hpp>
+#include <sdeventplus/utility/timer_group.hpp>
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace sdeventplus
+{
+namespace utility
+{
+
+template <ClockId Id>
+TimerGroup<Id>::TimerGroup(const Event& event, Duration slack) :
+    clock(event),
+    slack(slack > Duration::zero()
+              ? slack
+              : throw std::invalid_argument("TimerGroup slack")),
+    // The group already delays expirations by the slack, so the wakeup
+    // itself should be precise
+    timeSource(event, typename source::Time<Id>::TimePoint(),
+               typename source::Time<Id>::Accuracy{1},
+               [this](source::Time<Id>&,
+                      typename source::Time<Id>::TimePoint) { expire(); })
+{
+    timeSource.set_enabled(source::Enabled::Off);
+}
+
+template <ClockId Id>
+const Event& TimerGroup<Id>::get_event() const
+{
+    return timeSource.get_event();
+}
+
+template <ClockId Id>
+typename TimerGroup<Id>::Duration TimerGroup<Id>::get_slack() const
+{
+    return slack;
+}
+
+template <ClockId Id>
+uint64_t TimerGroup<Id>::add(Duration interval, Callback&& callback)
+{
+    if (interval <= Duration::zero())
+    {
+        throw std::invalid_argument("TimerGroup interval");
+    }
+    const uint64_t key = nextKey++;
+    Member& member = members[key];
+    member.callback = std::move(callback);
+    member.interval = interval;
+    member.deadline = clock.now().time_since_epoch() + interval;
+    insert(key, member);
+    armSource();
+    return key;
+}
+
+template <ClockId Id>
+bool TimerGroup<Id>::remove(uint64_t key)
+{
+    auto it = members.find(key);
+    if (it == members.end())
+    {
+        return false;
+    }
+    if (it->second.scheduled != schedule.end())
+    {
+        schedule.erase(it->second.scheduled);
+    }
+    members.erase(it);
+    armSource();
+    return true;
+}
+
+template <ClockId Id>
+size_t TimerGroup<Id>::size() const
+{
+    return members.size();
+}
+
+template <ClockId Id>
+const typename TimerGroup<Id>::Stats& TimerGroup<Id>::get_stats() const
+{
+    return stats;
+}
+
+template <ClockId Id>
+void TimerGroup<Id>::reset_stats()
+{
+    stats = {};
+}
+
+template <ClockId Id>
+void TimerGroup<Id>::insert(uint64_t key, Member& member)
+{
+    const uint64_t window = (member.deadline + slack - Duration{1}) / slack;
+    member.scheduled = schedule.emplace(window, key);
+}
+
+template <ClockId Id>
+void TimerGroup<Id>::armSource()
+{
+    if (expiring)
+    {
+        return;
+    }
+    if (schedule.empty())
+    {
+        if (armedWindow != disarmed)
+        {
+            timeSource.set_enabled(source::Enabled::Off);
+            armedWindow = disarmed;
+        }
+        return;
+    }
+    const uint64_t window = schedule.begin()->first;
+    if (window == armedWindow)
+    {
+        return;
+    }
+    timeSource.set_time(typename source::Time<Id>::TimePoint(slack * window));
+    if (armedWindow == disarmed)
+    {
+        timeSource.set_enabled(source::Enabled::OneShot);
+    }
+    armedWindow = window;
+}
+
+template <ClockId Id>
+void TimerGroup<Id>::expire()
+{
+    // The source disabled itself, it is armed again once all due timers ran
+    armedWindow = disarmed;
+    expiring = true;
+    stats.wakeups++;
+    const Duration now = clock.now().time_since_epoch();
+
+    std::vector<uint64_t> due;
+    const uint64_t window = now / slack;
+    auto end = schedule.upper_bound(window);
+    for (auto it = schedule.begin(); it != end; ++it)
+    {
+        due.push_back(it->second);
+        members.at(it->second).scheduled = schedule.end();
+    }
+    schedule.erase(schedule.begin(), end);
+
+    internal::DestroyGuard::Scope scope(guard);
+    for (uint64_t key : due)
+    {
+        auto it = members.find(key);
+        if (it == members.end())
+        {
+            continue;
+        }
+        // The callback is kept aside so the timer, or the whole group, can
+        // be removed while it is running
+        Callback callback = std::move(it->second.callback);
+        stats.dispatches++;
+        internal::loggedCall("TimerGroup", callback);
+        if (scope.gone())
+        {
+            return;
+        }
+        it = members.find(key);
+        if (it == members.end())
+        {
+            continue;
+        }
+        Member& member = it->second;
+        member.callback = std::move(callback);
+        member.deadline += member.interval;
+        if (member.deadline <= now)
+        {
+            member.deadline = now + member.interval;
+        }
+        insert(key, member);
+    }
+
+    expiring = false;
+    armSource();
+}
+
+template class TimerGroup<ClockId::RealTime>;
+template class TimerGroup<ClockId::Monotonic>;
+template class TimerGroup<ClockId::BootTime>;
+template class TimerGroup<ClockId::RealTimeAlarm>;
+template class TimerGroup<ClockId::BootTimeAlarm>;
+
+} // namespace utility
+} // namespace sdeventplus
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <function2/function2.hpp>
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/internal/destroy_guard.hpp>
+#include <sdeventplus/source/time.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <unordered_map>
+
+namespace sdeventplus
+{
+namespace utility
+{
+
+/** @class TimerGroup<Id>
+ *  @brief A set of repeating timers sharing wakeups from a single time source
+ *  @details Every expiration is delayed to the next multiple of the slack
+ *           window on the clock, so timers whose deadlines fall into the
+ *           same window are dispatched together by one wakeup. This is the
+ *           same idea as the accuracy of a time source, which lets sd-event
+ *           move the wakeup within a window shared by all sources, but
+ *           applied to a known set of timers with a window of their own and
+ *           counted so the benefit can be measured.
+ *
+ *           Each timer keeps its nominal schedule, advancing by its interval
+ *           from the previous deadline, so the slack never accumulates.
+ *           A timer falling more than an interval behind restarts its
+ *           schedule from the current time.
+ */
+template <ClockId Id>
+class TimerGroup
+{
+  public:
+    /** @brief Type used to represent time durations */
+    using Duration = typename Clock<Id>::duration;
+
+    /** @brief Type of the user provided callback run when a timer elapses */
+    using Callback = fu2::unique_function<void()>;
+
+    /** @brief Counters describing how well timers were coalesced */
+    struct Stats
+    {
+        /** @brief Number of times the group woke up the event loop */
+        uint64_t wakeups = 0;
+        /** @brief Number of timer callbacks run */
+        uint64_t dispatches = 0;
+
+        /** @brief The average number of timers dispatched per wakeup
+         *
+         *  @return The ratio, 0 if the group never woke up
+         */
+        double coalescingRatio() const
+        {
+            return wakeups == 0 ? 0 : static_cast<double>(dispatches) / wakeups;
+        }
+    };
+
+    /** @brief Creates a new, empty timer group on the given event loop
+     *
+     *  @param[in] event - The event the timers run on
+     *  @param[in] slack - The window timers are coalesced into
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    TimerGroup(const Event& event, Duration slack);
+
+    TimerGroup(const TimerGroup& other) = delete;
+    TimerGroup& operator=(const TimerGroup& other) = delete;
+    TimerGroup(TimerGroup&& other) = delete;
+    TimerGroup& operator=(TimerGroup&& other) = delete;
+
+    /** @brief Gets the associated Event object
+     *
+     *  @return The Event
+     */
+    const Event& get_event() const;
+
+    /** @brief Gets the slack window of the group
+     *
+     *  @return The slack
+     */
+    Duration get_slack() const;
+
+    /** @brief Adds a timer running the callback every interval, starting one
+     *         interval from now
+     *
+     *  @param[in] interval - The time in-between timer expirations
+     *  @param[in] callback - The user provided callback run when elapsing
+     *  @throws SdEventError for underlying sd_event errors
+     *  @return The key identifying the timer in the group
+     */
+    uint64_t add(Duration interval, Callback&& callback);
+
+    /** @brief Removes a timer from the group, which is allowed from any
+     *         callback of the group
+     *
+     *  @param[in] key - The key returned when the timer was added
+     *  @return 'true' if the timer was removed, 'false' if it was not found
+     */
+    bool remove(uint64_t key);
+
+    /** @brief Gets the number of timers in the group
+     *
+     *  @return The number of timers
+     */
+    size_t size() const;
+
+    /** @brief Gets the coalescing counters of the group
+     *
+     *  @return The counters
+     */
+    const Stats& get_stats() const;
+
+    /** @brief Resets the coalescing counters of the group */
+    void reset_stats();
+
+  private:
+    static constexpr uint64_t disarmed = std::numeric_limits<uint64_t>::max();
+
+    /** @brief Timers ordered by the slack window they expire in */
+    using Schedule = std::multimap<uint64_t, uint64_t>;
+
+    struct Member
+    {
+        Callback callback;
+        Duration interval;
+        /** @brief The deadline before applying the slack */
+        Duration deadline;
+        /** @brief The schedule entry, or the end while being dispatched */
+        Schedule::iterator scheduled;
+    };
+
+    Clock<Id> clock;
+    Duration slack;
+    std::unordered_map<uint64_t, Member> members;
+    Schedule schedule;
+    uint64_t nextKey = 0;
+    /** @brief The slack window the time source is armed for */
+    uint64_t armedWindow = disarmed;
+    bool expiring = false;
+    internal::DestroyGuard guard;
+    Stats stats;
+    source::Time<Id> timeSource;
+
+    void insert(uint64_t key, Member& member);
+    void armSource();
+    void expire();
+};
+
+} // namespace utility
+} // namespace sdeventplus
@@ -0,0 +1,354 @@
+#include <sdeventplus/internal/logged_call.hpp>
+#include <sdeventplus/source/base.hpp>
+#include <sdeventplus/utility/timer_wheel.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <utility>
+
+namespace sdeventplus
+{
+namespace utility
+{
+
+template <ClockId Id>
+TimerWheel<Id>::TimerWheel(const Event& event, Duration resolution) :
+    clock(event), resolution(resolution), current(0),
+    timeSource(event, typename source::Time<Id>::TimePoint(),
+               std::chrono::duration_cast<
+                   typename source::Time<Id>::Accuracy>(resolution),
+               [this](source::Time<Id>&,
+                      typename source::Time<Id>::TimePoint) { expire(); })
+{
+    if (resolution <= Duration::zero())
+    {
+        throw std::invalid_argument("TimerWheel resolution");
+    }
+    heads.fill(none);
+    timeSource.set_enabled(source::Enabled::Off);
+    current = tickNow();
+}
+
+template <ClockId Id>
+const Event& TimerWheel<Id>::get_event() const
+{
+    return timeSource.get_event();
+}
+
+template <ClockId Id>
+typename TimerWheel<Id>::Handle TimerWheel<Id>::add(Duration timeout,
+                                                    Callback&& callback)
+{
+    const uint64_t expiry = deadline(timeout);
+    // Arm before touching the nodes so a failure leaves no orphaned timer
+    armSource(expiry);
+    uint32_t index = freeNodes;
+    if (index == none)
+    {
+        index = nodes.size();
+        nodes.emplace_back();
+    }
+    else
+    {
+        freeNodes = nodes[index].next;
+    }
+    Node& node = nodes[index];
+    node.callback = std::move(callback);
+    node.expiry = expiry;
+    node.used = true;
+    place(index);
+    armed++;
+    return Handle{index, node.generation};
+}
+
+template <ClockId Id>
+bool TimerWheel<Id>::rearm(Handle handle, Duration timeout)
+{
+    Node* node = lookup(handle);
+    if (node == nullptr)
+    {
+        return false;
+    }
+    const uint64_t expiry = deadline(timeout);
+    // On failure the timer keeps its previous expiration
+    armSource(expiry);
+    if (node->list == noList)
+    {
+        // Rearmed from its own callback
+        armed++;
+    }
+    else
+    {
+        unlink(handle.index);
+    }
+    node->expiry = expiry;
+    place(handle.index);
+    return true;
+}
+
+template <ClockId Id>
+bool TimerWheel<Id>::cancel(Handle handle)
+{
+    Node* node = lookup(handle);
+    if (node == nullptr)
+    {
+        return false;
+    }
+    if (node->list != noList)
+    {
+        unlink(handle.index);
+        armed--;
+    }
+    if (node->running)
+    {
+        // The callback is released once it returns
+        node->generation++;
+        return true;
+    }
+    release(handle.index);
+    // The time source stays armed, a spurious wakeup is cheaper than finding
+    // the new earliest timer on every cancellation
+    return true;
+}
+
+template <ClockId Id>
+bool TimerWheel<Id>::pending(Handle handle) const
+{
+    const Node* node = lookup(handle);
+    return node != nullptr && node->list != noList;
+}
+
+template <ClockId Id>
+size_t TimerWheel<Id>::size() const
+{
+    return armed;
+}
+
+template <ClockId Id>
+typename TimerWheel<Id>::Node* TimerWheel<Id>::lookup(Handle handle)
+{
+    return const_cast<Node*>(std::as_const(*this).lookup(handle));
+}
+
+template <ClockId Id>
+const typename TimerWheel<Id>::Node*
+    TimerWheel<Id>::lookup(Handle handle) const
+{
+    if (handle.index >= nodes.size())
+    {
+        return nullptr;
+    }
+    const Node& node = nodes[handle.index];
+    if (!node.used || node.generation != handle.generation)
+    {
+        return nullptr;
+    }
+    return &node;
+}
+
+template <ClockId Id>
+uint64_t TimerWheel<Id>::tickNow() const
+{
+    return clock.now().time_since_epoch() / resolution;
+}
+
+template <ClockId Id>
+uint64_t TimerWheel<Id>::deadline(Duration timeout) const
+{
+    const Duration now = clock.now().time_since_epoch();
+    timeout = std::max(timeout, Duration::zero());
+    timeout = std::min(timeout, Duration::max() - now);
+    // Timers never fire early, so the first tick after the expiration
+    const uint64_t expiry = (now + timeout) / resolution + 1;
+    return std::max(expiry, current + 1);
+}
+
+template <ClockId Id>
+void TimerWheel<Id>::link(uint32_t index, uint16_t list)
+{
+    Node& node = nodes[index];
+    node.list = list;
+    node.prev = none;
+    node.next = heads[list];
+    if (node.next != none)
+    {
+        nodes[node.next].prev = index;
+    }
+    heads[list] = index;
+    if (list < dueList)
+    {
+        occupied[list / slots] |= uint64_t{1} << (list % slots);
+    }
+}
+
+template <ClockId Id>
+void TimerWheel<Id>::unlink(uint32_t index)
+{
+    Node& node = nodes[index];
+    if (node.prev != none)
+    {
+        nodes[node.prev].next = node.next;
+    }
+    else
+    {
+        heads[node.list] = node.next;
+    }
+    if (node.next != none)
+    {
+        nodes[node.next].prev = node.prev;
+    }
+    if (node.list < dueList && heads[node.list] == none)
+    {
+        occupied[node.list / slots] &= ~(uint64_t{1} << (node.list % slots));
+    }
+    node.list = noList;
+}
+
+template <ClockId Id>
+void TimerWheel<Id>::place(uint32_t index)
+{
+    const uint64_t expiry = nodes[index].expiry;
+    if (expiry <= current)
+    {
+        link(index, dueList);
+        return;
+    }
+    // The level is picked by the highest bit the expiration differs from the
+    // current tick, so each level only holds the next 64 of its slots
+    const size_t level = (63 - std::countl_zero(expiry ^ current)) / slotBits;
+    const size_t slot = (expiry >> (level * slotBits)) % slots;
+    link(index, level * slots + slot);
+}
+
+template <ClockId Id>
+void TimerWheel<Id>::release(uint32_t index)
+{
+    Node& node = nodes[index];
+    node.callback = nullptr;
+    node.used = false;
+    node.generation++;
+    node.next = freeNodes;
+    freeNodes = index;
+}
+
+template <ClockId Id>
+uint64_t TimerWheel<Id>::nextTick() const
+{
+    for (size_t level = 0; level < levels; ++level)
+    {
+        if (occupied[level] == 0)
+        {
+            continue;
+        }
+        // The first tick covered by the earliest occupied slot, lower levels
+        // always expire before higher ones
+        const size_t shift = (level + 1) * slotBits;
+        const uint64_t base = shift >= 64 ? 0 : (current >> shift) << shift;
+        const uint64_t slot = std::countr_zero(occupied[level]);
+        return base | (slot << (level * slotBits));
+    }
+    return disarmed;
+}
+
+template <ClockId Id>
+void TimerWheel<Id>::advance(uint64_t tick)
+{
+    current = tick;
+    // Redistribute the higher level slots starting at this tick
+    for (size_t level = levels - 1; level > 0; --level)
+    {
+        const size_t shift = level * slotBits;
+        if (tick % (uint64_t{1} << shift) != 0)
+        {
+            continue;
+        }
+        const uint16_t list = level * slots + (tick >> shift) % slots;
+        while (heads[list] != none)
+        {
+            const uint32_t index = heads[list];
+            unlink(index);
+            place(index);
+        }
+    }
+    const uint16_t list = tick % slots;
+    while (heads[list] != none)
+    {
+        const uint32_t index = heads[list];
+        unlink(index);
+        link(index, dueList);
+    }
+}
+
+template <ClockId Id>
+void TimerWheel<Id>::armSource(uint64_t tick)
+{
+    if (expiring || tick >= armedTick)
+    {
+        return;
+    }
+    const uint64_t maxTick = Duration::max() / resolution;
+    const auto time = typename source::Time<Id>::TimePoint(
+        tick > maxTick ? Duration::max() : resolution * tick);
+    timeSource.set_time(time);
+    if (armedTick == disarmed)
+    {
+        timeSource.set_enabled(source::Enabled::OneShot);
+    }
+    armedTick = tick;
+}
+
+template <ClockId Id>
+void TimerWheel<Id>::expire()
+{
+    // The source disabled itself, it is armed again once all due timers ran
+    armedTick = disarmed;
+    expiring = true;
+    const uint64_t now = tickNow();
+    internal::DestroyGuard::Scope scope(guard);
+    for (uint64_t tick = nextTick(); tick <= now; tick = nextTick())
+    {
+        advance(tick);
+        while (heads[dueList] != none)
+        {
+            const uint32_t index = heads[dueList];
+            unlink(index);
+            armed--;
+            Node& node = nodes[index];
+            node.running = true;
+            // Held aside so the wheel may be destroyed by the callback
+            Callback callback = std::move(node.callback);
+            internal::loggedCall("TimerWheel", callback,
+                                 Handle{index, node.generation});
+            if (scope.gone())
+            {
+                return;
+            }
+            nodes[index].running = false;
+            if (nodes[index].list == noList)
+            {
+                release(index);
+            }
+            else
+            {
+                nodes[index].callback = std::move(callback);
+            }
+        }
+    }
+    current = std::max(current, now);
+    expiring = false;
+    const uint64_t next = nextTick();
+    if (next != disarmed)
+    {
+        armSource(next);
+    }
+}
+
+template class TimerWheel<ClockId::RealTime>;
+template class TimerWheel<ClockId::Monotonic>;
+template class TimerWheel<ClockId::BootTime>;
+template class TimerWheel<ClockId::RealTimeAlarm>;
+template class TimerWheel<ClockId::BootTimeAlarm>;
+
+} // namespace utility
+} // namespace sdeventplus
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <function2/function2.hpp>
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/internal/destroy_guard.hpp>
+#include <sdeventplus/source/time.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+
+namespace sdeventplus
+{
+namespace utility
+{
+
+/** @class TimerWheel<Id>
+ *  @brief Multiplexes any number of one shot timers onto a single time
+ *         source using a hierarchical timing wheel
+ *  @details Expiration times are rounded up to a fixed resolution and kept
+ *           in 11 levels of 64 slots, each level covering 64 times the
+ *           range of the one below. Adding, cancelling and rearming a timer
+ *           are O(1) and never touch sd-event unless the timer becomes the
+ *           earliest one. Timers far in the future are moved to lower
+ *           levels as their slot comes up, at most once per level.
+ *
+ *           A timer costs a slot entry holding its callback instead of its
+ *           own sd_event_source, which makes the wheel suited for large
+ *           numbers of mostly cancelled or restarted timeouts. Timers fire
+ *           up to one resolution late, plus the accuracy of the time
+ *           source which is set to the resolution.
+ */
+template <ClockId Id>
+class TimerWheel
+{
+  public:
+    /** @brief Type used to represent timeouts and the wheel resolution */
+    using Duration = typename Clock<Id>::duration;
+
+    /** @brief Identifies a timer added to the wheel
+     *         Stays invalid once the timer fired or was cancelled, even if
+     *         its slot is reused. Timers expiring in the same tick fire in
+     *         no particular order.
+     */
+    struct Handle
+    {
+        uint32_t index;
+        uint32_t generation;
+    };
+
+    /** @brief Type of the user provided callback run when the timer fires.
+     *         The timer can be rearmed from its callback with the handle,
+     *         otherwise it is released once the callback returns.
+     */
+    using Callback = fu2::unique_function<void(Handle handle)>;
+
+    /** @brief Creates a new, empty timer wheel on the given event loop
+     *
+     *  @param[in] event      - The event the timers run on
+     *  @param[in] resolution - The granularity of the timer expirations
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    explicit TimerWheel(const Event& event,
+                        Duration resolution = std::chrono::milliseconds{1});
+
+    TimerWheel(const TimerWheel& other) = delete;
+    TimerWheel& operator=(const TimerWheel& other) = delete;
+    TimerWheel(TimerWheel&& other) = delete;
+    TimerWheel& operator=(TimerWheel&& other) = delete;
+
+    /** @brief Gets the associated Event object
+     *
+     *  @return The Event
+     */
+    const Event& get_event() const;
+
+    /** @brief Adds a one shot timer
+     *
+     *  @param[in] timeout  - The time until the callback should run
+     *  @param[in] callback - The callback to run
+     *  @throws SdEventError for underlying sd_event errors
+     *  @return The handle of the new timer
+     */
+    Handle add(Duration timeout, Callback&& callback);
+
+    /** @brief Moves the expiration of a timer to timeout from now
+     *         Also rearms a timer from inside its own callback.
+     *
+     *  @param[in] handle  - The handle of the timer
+     *  @param[in] timeout - The time until the callback should run
+     *  @throws SdEventError for underlying sd_event errors
+     *  @return 'true' if the timer was rearmed
+     *          'false' if the handle is no longer valid
+     */
+    bool rearm(Handle handle, Duration timeout);
+
+    /** @brief Removes a timer without running its callback
+     *
+     *  @param[in] handle - The handle of the timer
+     *  @return 'true' if the timer was cancelled
+     *          'false' if the handle is no longer valid
+     */
+    bool cancel(Handle handle);
+
+    /** @brief Whether or not the timer is waiting to fire
+     *
+     *  @param[in] handle - The handle of the timer
+     *  @return 'true' if the timer is armed
+     */
+    bool pending(Handle handle) const;
+
+    /** @brief Gets the number of armed timers
+     *
+     *  @return The number of timers
+     */
+    size_t size() const;
+
+  private:
+    static constexpr size_t slotBits = 6;
+    static constexpr size_t slots = size_t{1} << slotBits;
+    static constexpr size_t levels = (64 + slotBits - 1) / slotBits;
+    /** @brief Index of the list holding timers due at the current tick */
+    static constexpr uint16_t dueList = levels * slots;
+    static constexpr uint16_t noList = dueList + 1;
+    static constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+    static constexpr uint64_t disarmed = std::numeric_limits<uint64_t>::max();
+
+    struct Node
+    {
+        Callback callback;
+        uint64_t expiry = 0;
+        uint32_t prev = none;
+        uint32_t next = none;
+        uint32_t generation = 0;
+        uint16_t list = noList;
+        bool used = false;
+        bool running = false;
+    };
+
+    Clock<Id> clock;
+    Duration resolution;
+    /** @brief A deque so growing never moves the callbacks of other timers */
+    std::deque<Node> nodes;
+    uint32_t freeNodes = none;
+    size_t armed = 0;
+    /** @brief The last tick the wheel was advanced to */
+    uint64_t current;
+    /** @brief The tick the time source is armed for */
+    uint64_t armedTick = disarmed;
+    bool expiring = false;
+    std::array<uint32_t, levels * slots + 1> heads;
+    std::array<uint64_t, levels> occupied = {};
+    internal::DestroyGuard guard;
+    source::Time<Id> timeSource;
+
+    Node* lookup(Handle handle);
+    const Node* lookup(Handle handle) const;
+    uint64_t tickNow() const;
+    uint64_t deadline(Duration timeout) const;
+    void link(uint32_t index, uint16_t list);
+    void unlink(uint32_t index);
+    void place(uint32_t index);
+    void release(uint32_t index);
+    uint64_t nextTick() const;
+    void advance(uint64_t tick);
+    void armSource(uint64_t tick);
+    void expire();
+};
+
+} // namespace utility
+} // namespace sdeventplus
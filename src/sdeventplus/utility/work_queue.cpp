@@ -0,0 +1,160 @@
+#include <sdeventplus/internal/destroy_guard.hpp>
+#include <sdeventplus/internal/logged_call.hpp>
+#include <sdeventplus/source/base.hpp>
+#include <sdeventplus/utility/work_queue.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace sdeventplus
+{
+namespace utility
+{
+
+namespace detail
+{
+
+/** @class WorkQueueData
+ *  @brief The ring buffer of tasks drained by the Defer source of a WorkQueue
+ */
+class WorkQueueData
+{
+  public:
+    explicit WorkQueueData(size_t budget) : budget(std::max<size_t>(budget, 1))
+    {}
+
+    /** @brief Adds a task at the tail of the ring */
+    void push(WorkQueue::Task&& task)
+    {
+        if (count == slots.size())
+        {
+            grow();
+        }
+        slots[(head + count) & (slots.size() - 1)] = std::move(task);
+        count++;
+    }
+
+    /** @brief Runs up to budget tasks from the head of the ring, disabling
+     *         the source once none remain
+     *         A task may destroy the WorkQueue, which ends the dispatch.
+     *
+     *  @param[in] source - The Defer source of the queue
+     */
+    void drain(source::EventBase& source)
+    {
+        internal::DestroyGuard::Scope scope(guard);
+        // Tasks posted from a running task join the tail and still run in
+        // this dispatch if the budget allows
+        for (size_t i = 0; i < budget && count > 0; ++i)
+        {
+            WorkQueue::Task task = std::move(slots[head]);
+            head = (head + 1) & (slots.size() - 1);
+            count--;
+            internal::loggedCall("WorkQueue", task);
+            if (scope.gone())
+            {
+                return;
+            }
+        }
+        if (count == 0)
+        {
+            source.set_enabled(source::Enabled::Off);
+            enabled = false;
+        }
+    }
+
+    size_t count = 0;
+    size_t budget;
+    /** @brief Whether the Defer source is currently enabled */
+    bool enabled = false;
+
+  private:
+    /** @brief Storage for the ring, its size is always a power of two */
+    std::vector<WorkQueue::Task> slots;
+    size_t head = 0;
+    internal::DestroyGuard guard;
+
+    void grow()
+    {
+        std::vector<WorkQueue::Task> next(
+            std::max<size_t>(slots.size() * 2, 16));
+        for (size_t i = 0; i < count; ++i)
+        {
+            next[i] = std::move(slots[(head + i) & (slots.size() - 1)]);
+        }
+        slots = std::move(next);
+        head = 0;
+    }
+};
+
+/** @brief Returns the data of a WorkQueue
+ *
+ *  @throws std::runtime_error if the WorkQueue was moved from
+ */
+static WorkQueueData& checked(const std::unique_ptr<WorkQueueData>& data)
+{
+    if (!data)
+    {
+        throw std::runtime_error("WorkQueue was moved from");
+    }
+    return *data;
+}
+
+} // namespace detail
+
+WorkQueue::WorkQueue(const Event& event, size_t budget) :
+    data(std::make_unique<detail::WorkQueueData>(budget)),
+    defer(event,
+          [data = data.get()](source::EventBase& source) { data->drain(source); })
+{
+    defer.set_enabled(source::Enabled::Off);
+}
+
+WorkQueue::WorkQueue(WorkQueue&& other) = default;
+WorkQueue& WorkQueue::operator=(WorkQueue&& other)
+{
+    // Release the old source before the state its callback points to
+    defer = std::move(other.defer);
+    data = std::move(other.data);
+    return *this;
+}
+
+WorkQueue::~WorkQueue() = default;
+
+void WorkQueue::post(Task&& task)
+{
+    auto& d = detail::checked(data);
+    d.push(std::move(task));
+    if (!d.enabled)
+    {
+        defer.set_enabled(source::Enabled::On);
+        d.enabled = true;
+    }
+}
+
+size_t WorkQueue::size() const
+{
+    return detail::checked(data).count;
+}
+
+size_t WorkQueue::get_budget() const
+{
+    return detail::checked(data).budget;
+}
+
+void WorkQueue::set_budget(size_t budget)
+{
+    detail::checked(data).budget = std::max<size_t>(budget, 1);
+}
+
+const Event& WorkQueue::get_event() const
+{
+    return defer.get_event();
+}
+
+} // namespace utility
+} // namespace sdeventplus
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <function2/function2.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+
+#include <cstddef>
+#include <memory>
+
+namespace sdeventplus
+{
+namespace utility
+{
+
+namespace detail
+{
+class WorkQueueData;
+} // namespace detail
+
+/** @class WorkQueue
+ *  @brief Runs deferred tasks posted on the loop thread from a single Defer
+ *         source
+ *  @details Tasks are kept in a ring buffer instead of a Defer source each,
+ *           so posting a task does not create any sd_event_source. The
+ *           Defer source is only enabled while tasks are queued, and each
+ *           dispatch runs at most budget tasks in posting order so a long
+ *           queue does not starve the other sources of the loop.
+ *
+ *           Unlike Executor, posting is not thread safe and must happen on
+ *           the thread running the event loop. Tasks still queued when the
+ *           WorkQueue is destroyed are dropped without running.
+ */
+class WorkQueue
+{
+  public:
+    using Task = fu2::unique_function<void()>;
+
+    /** @brief Creates a new work queue on the given event loop
+     *
+     *  @param[in] event  - The event the tasks are run on
+     *  @param[in] budget - The maximum number of tasks run per dispatch
+     *  @throws SdEventError for underlying sd_event errors
+     */
+    explicit WorkQueue(const Event& event, size_t budget = 64);
+
+    WorkQueue(WorkQueue&& other);
+    WorkQueue& operator=(WorkQueue&& other);
+    WorkQueue(const WorkQueue& other) = delete;
+    WorkQueue& operator=(const WorkQueue& other) = delete;
+    ~WorkQueue();
+
+    /** @brief Queues a task to be run on a later loop iteration
+     *
+     *  @param[in] task - The task to run
+     *  @throws SdEventError for underlying sd_event errors
+     *  @throws std::runtime_error if the queue was moved from
+     */
+    void post(Task&& task);
+
+    /** @brief Gets the number of tasks waiting to run
+     *
+     *  @throws std::runtime_error if the queue was moved from
+     *  @return The number of queued tasks
+     */
+    size_t size() const;
+
+    /** @brief Gets the maximum number of tasks run per dispatch
+     *
+     *  @throws std::runtime_error if the queue was moved from
+     *  @return The budget
+     */
+    size_t get_budget() const;
+
+    /** @brief Sets the maximum number of tasks run per dispatch
+     *
+     *  @param[in] budget - The new budget, 0 is treated as 1
+     *  @throws std::runtime_error if the queue was moved from
+     */
+    void set_budget(size_t budget);
+
+    /** @brief Gets the associated Event object
+     *
+     *  @return The Event
+     */
+    const Event& get_event() const;
+
+  private:
+    std::unique_ptr<detail::WorkQueueData> data;
+    source::Defer defer;
+};
+
+} // namespace utility
+} // namespace sdeventplus
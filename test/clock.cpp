@@ -6,6 +6,7 @@
 #include <sdeventplus/test/sdevent.hpp>
 
 #include <cerrno>
+#include <system_error>
 #include <type_traits>
 #include <utility>
 
@@ -57,5 +58,18 @@ TEST_F(ClockTest, MoveEvent)
     EXPECT_CALL(mock, sd_event_unref(expected_event)).WillOnce(Return(nullptr));
 }
 
+TEST_F(ClockTest, TryNowMovedFrom)
+{
+    Event event(expected_event, std::false_type(), &mock);
+
+    Clock<ClockId::Monotonic> clock(std::move(event));
+    Clock<ClockId::Monotonic> moved(std::move(clock));
+    auto now = clock.try_now();
+    ASSERT_FALSE(now);
+    EXPECT_EQ(std::errc::bad_file_descriptor, now.error());
+
+    EXPECT_CALL(mock, sd_event_unref(expected_event)).WillOnce(Return(nullptr));
+}
+
 } // namespace
 } // namespace sdeventplus
@@ -0,0 +1,184 @@
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/coroutine.hpp>
+#include <sdeventplus/event.hpp>
+#include <stdplus/signal.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+namespace sdeventplus
+{
+namespace
+{
+
+constexpr ClockId testClock = ClockId::Monotonic;
+
+class CoroutineTest : public testing::Test
+{
+  protected:
+    Event event = Event::get_new();
+    int efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    ~CoroutineTest()
+    {
+        close(efd);
+    }
+
+    void runUntilDone(const auto& t)
+    {
+        while (!t.done())
+        {
+            ASSERT_LT(0, event.run(std::chrono::seconds{5}));
+        }
+    }
+};
+
+TEST_F(CoroutineTest, Lazy)
+{
+    bool ran = false;
+    auto t = [](bool& ran) -> task<int> {
+        ran = true;
+        co_return 42;
+    }(ran);
+    EXPECT_FALSE(ran);
+    EXPECT_FALSE(t.done());
+    t.start();
+    EXPECT_TRUE(ran);
+    ASSERT_TRUE(t.done());
+    EXPECT_EQ(42, t.get());
+}
+
+TEST_F(CoroutineTest, IoReady)
+{
+    auto t = [](Event& event, int fd) -> task<uint64_t> {
+        uint32_t revents = co_await io_ready(event, fd, EPOLLIN);
+        EXPECT_TRUE(revents & EPOLLIN);
+        uint64_t val;
+        EXPECT_EQ(sizeof(val), read(fd, &val, sizeof(val)));
+        co_return val;
+    }(event, efd);
+    t.start();
+    EXPECT_FALSE(t.done());
+    EXPECT_EQ(0, event.run(std::chrono::seconds{0}));
+
+    uint64_t val = 5;
+    ASSERT_EQ(sizeof(val), write(efd, &val, sizeof(val)));
+    runUntilDone(t);
+    EXPECT_EQ(5, t.get());
+}
+
+TEST_F(CoroutineTest, SleepFor)
+{
+    auto t = [](Event& event) -> task<> {
+        auto start = Clock<testClock>(event).now();
+        for (int i = 0; i < 3; ++i)
+        {
+            co_await sleep_for<testClock>(event, std::chrono::milliseconds{1},
+                                          std::chrono::microseconds{1});
+        }
+        EXPECT_LE(std::chrono::milliseconds{3},
+                  Clock<testClock>(event).now() - start);
+    }(event);
+    t.start();
+    runUntilDone(t);
+    t.get();
+}
+
+TEST_F(CoroutineTest, NextSignal)
+{
+    stdplus::signal::block(SIGUSR2);
+    auto t = [](Event& event) -> task<int> {
+        auto info = co_await next_signal(event, SIGUSR2);
+        co_return info.ssi_signo;
+    }(event);
+    t.start();
+    ASSERT_EQ(0, raise(SIGUSR2));
+    runUntilDone(t);
+    EXPECT_EQ(SIGUSR2, t.get());
+}
+
+TEST_F(CoroutineTest, ChildExit)
+{
+    stdplus::signal::block(SIGCHLD);
+    pid_t pid = fork();
+    ASSERT_LE(0, pid);
+    if (pid == 0)
+    {
+        _exit(3);
+    }
+    auto t = [](Event& event, pid_t pid) -> task<int> {
+        auto info = co_await child_exit(event, pid);
+        EXPECT_EQ(CLD_EXITED, info.si_code);
+        co_return info.si_status;
+    }(event, pid);
+    t.start();
+    runUntilDone(t);
+    EXPECT_EQ(3, t.get());
+    waitpid(pid, nullptr, WNOHANG);
+}
+
+TEST_F(CoroutineTest, AwaitTask)
+{
+    auto child = [](Event& event, int fd) -> task<int> {
+        co_await io_ready(event, fd, EPOLLIN);
+        co_return 7;
+    };
+    auto thrower = []() -> task<> {
+        throw std::runtime_error("thrower");
+        co_return;
+    };
+    // The capturing closure has to outlive the coroutine
+    auto parentFn = [&](Event& event, int fd) -> task<int> {
+        int sum = co_await child(event, fd);
+        sum += co_await child(event, fd);
+        EXPECT_THROW(co_await thrower(), std::runtime_error);
+        co_return sum;
+    };
+    auto parent = parentFn(event, efd);
+    parent.start();
+    EXPECT_FALSE(parent.done());
+
+    uint64_t val = 1;
+    ASSERT_EQ(sizeof(val), write(efd, &val, sizeof(val)));
+    runUntilDone(parent);
+    EXPECT_EQ(14, parent.get());
+}
+
+TEST_F(CoroutineTest, Exception)
+{
+    auto t = [](Event& event) -> task<int> {
+        co_await sleep_for<testClock>(event, std::chrono::microseconds{1});
+        throw std::runtime_error("task");
+    }(event);
+    t.start();
+    runUntilDone(t);
+    EXPECT_THROW(t.get(), std::runtime_error);
+}
+
+TEST_F(CoroutineTest, DestroySuspended)
+{
+    bool resumed = false;
+    {
+        auto t = [](Event& event, int fd, bool& resumed) -> task<> {
+            co_await io_ready(event, fd, EPOLLIN);
+            resumed = true;
+        }(event, efd, resumed);
+        t.start();
+    }
+    uint64_t val = 1;
+    ASSERT_EQ(sizeof(val), write(efd, &val, sizeof(val)));
+    EXPECT_EQ(0, event.run(std::chrono::seconds{0}));
+    EXPECT_FALSE(resumed);
+}
+
+} // namespace
+} // namespace sdeventplus
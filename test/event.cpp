@@ -1,9 +1,12 @@
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/exception.hpp>
+#include <sdeventplus/profile.hpp>
 #include <sdeventplus/test/sdevent.hpp>
 
+#include <chrono>
 #include <memory>
 #include <optional>
+#include <system_error>
 #include <type_traits>
 
 #include <gmock/gmock.h>
@@ -79,6 +82,38 @@ TEST_F(EventTest, CopyEventNoOwnCopy)
         .WillOnce(Return(nullptr));
 }
 
+TEST_F(EventTest, MoveEvent)
+{
+    Event event(expected_event, std::false_type(), &mock);
+    Event moved(std::move(event));
+    EXPECT_THROW(event.get(), std::bad_optional_access);
+    EXPECT_EQ(&mock, moved.getSdEvent());
+    EXPECT_EQ(expected_event, moved.get());
+
+    event = std::move(moved);
+    EXPECT_THROW(moved.get(), std::bad_optional_access);
+    EXPECT_EQ(expected_event, event.get());
+
+    EXPECT_CALL(mock, sd_event_unref(expected_event)).WillOnce(Return(nullptr));
+}
+
+TEST_F(EventTest, TryMovedFrom)
+{
+    Event event(expected_event, std::false_type(), &mock);
+    Event moved(std::move(event));
+    EXPECT_EQ(nullptr, event.get_or_null());
+    EXPECT_EQ(expected_event, moved.get_or_null());
+
+    auto run = event.try_run(std::nullopt);
+    ASSERT_FALSE(run);
+    EXPECT_EQ(std::errc::bad_file_descriptor, run.error());
+    auto exit = event.try_exit(0);
+    ASSERT_FALSE(exit);
+    EXPECT_EQ(std::errc::bad_file_descriptor, exit.error());
+
+    EXPECT_CALL(mock, sd_event_unref(expected_event)).WillOnce(Return(nullptr));
+}
+
 TEST_F(EventTest, GetNewEvent)
 {
     EXPECT_CALL(mock, sd_event_new(testing::_))
@@ -219,6 +254,248 @@ TEST_F(EventMethodTest, RunInternalError)
     EXPECT_THROW(event->run(std::nullopt), SdEventError);
 }
 
+TEST_F(EventMethodTest, TryRun)
+{
+    EXPECT_CALL(mock, sd_event_run(expected_event, static_cast<uint64_t>(-1)))
+        .WillOnce(Return(1));
+    EXPECT_EQ(1, event->try_run(std::nullopt));
+
+    EXPECT_CALL(mock, sd_event_run(expected_event, static_cast<uint64_t>(-1)))
+        .WillOnce(Return(-EINVAL));
+    auto ret = event->try_run(std::nullopt);
+    ASSERT_FALSE(ret);
+    EXPECT_EQ(std::errc::invalid_argument, ret.error());
+}
+
+TEST_F(EventMethodTest, RunProfiledPending)
+{
+    LoopProfile profile;
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_dispatch(expected_event))
+            .WillOnce(Return(1));
+    }
+    EXPECT_EQ(1, event->run(std::nullopt, profile));
+    EXPECT_EQ(1, profile.iterations());
+    EXPECT_EQ(0, profile.wait.count());
+    EXPECT_EQ(1, profile.dispatch.count());
+}
+
+TEST_F(EventMethodTest, RunProfiledWait)
+{
+    LoopProfile profile;
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(0));
+        EXPECT_CALL(mock,
+                    sd_event_wait(expected_event, static_cast<uint64_t>(-1)))
+            .WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_dispatch(expected_event))
+            .WillOnce(Return(1));
+    }
+    EXPECT_EQ(1, event->run(std::nullopt, profile));
+    EXPECT_EQ(1, profile.iterations());
+    EXPECT_EQ(1, profile.wait.count());
+    EXPECT_EQ(1, profile.dispatch.count());
+}
+
+TEST_F(EventMethodTest, RunProfiledTimeout)
+{
+    const std::chrono::microseconds timeout{20};
+    LoopProfile profile;
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(0));
+        EXPECT_CALL(mock, sd_event_wait(expected_event, timeout.count()))
+            .WillOnce(Return(0));
+    }
+    EXPECT_EQ(0, event->run(timeout, profile));
+    EXPECT_EQ(1, profile.iterations());
+    EXPECT_EQ(1, profile.wait.count());
+    EXPECT_EQ(0, profile.dispatch.count());
+}
+
+TEST_F(EventMethodTest, RunProfiledInternalError)
+{
+    LoopProfile profile;
+    EXPECT_CALL(mock, sd_event_prepare(expected_event))
+        .WillOnce(Return(-EINVAL));
+    EXPECT_THROW(event->run(std::nullopt, profile), SdEventError);
+}
+
+TEST_F(EventMethodTest, LoopProfiled)
+{
+    const int user_code = 10;
+    LoopProfile profile;
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_dispatch(expected_event))
+            .WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(0));
+        EXPECT_CALL(mock,
+                    sd_event_wait(expected_event, static_cast<uint64_t>(-1)))
+            .WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_dispatch(expected_event))
+            .WillOnce(Return(0));
+        EXPECT_CALL(mock, sd_event_get_exit_code(expected_event, testing::_))
+            .WillOnce(DoAll(SetArgPointee<1>(user_code), Return(0)));
+    }
+    EXPECT_EQ(user_code, event->loop(profile));
+    EXPECT_EQ(2, profile.iterations());
+    EXPECT_EQ(1, profile.wait.count());
+    EXPECT_EQ(2, profile.dispatch.count());
+}
+
+TEST_F(EventMethodTest, RunBatchDrain)
+{
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(0));
+        EXPECT_CALL(mock,
+                    sd_event_wait(expected_event, static_cast<uint64_t>(-1)))
+            .WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_dispatch(expected_event))
+            .WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_dispatch(expected_event))
+            .WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(0));
+        EXPECT_CALL(mock, sd_event_wait(expected_event, 0)).WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_dispatch(expected_event))
+            .WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(0));
+        EXPECT_CALL(mock, sd_event_wait(expected_event, 0)).WillOnce(Return(0));
+    }
+    EXPECT_EQ(3, event->run_batch(10, std::nullopt));
+}
+
+TEST_F(EventMethodTest, RunBatchMaxEvents)
+{
+    EXPECT_CALL(mock, sd_event_prepare(expected_event))
+        .Times(2)
+        .WillRepeatedly(Return(1));
+    EXPECT_CALL(mock, sd_event_dispatch(expected_event))
+        .Times(2)
+        .WillRepeatedly(Return(1));
+    EXPECT_EQ(2, event->run_batch(2, std::nullopt));
+
+    // At least one event is always dispatched
+    EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(1));
+    EXPECT_CALL(mock, sd_event_dispatch(expected_event)).WillOnce(Return(1));
+    EXPECT_EQ(1, event->run_batch(0, std::nullopt));
+}
+
+TEST_F(EventMethodTest, RunBatchBudget)
+{
+    EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(1));
+    EXPECT_CALL(mock, sd_event_dispatch(expected_event)).WillOnce(Return(1));
+    EXPECT_EQ(1, event->run_batch(10, std::chrono::microseconds{0}));
+}
+
+TEST_F(EventMethodTest, RunBatchTimeout)
+{
+    const std::chrono::microseconds timeout{20};
+    EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(0));
+    EXPECT_CALL(mock, sd_event_wait(expected_event, timeout.count()))
+        .WillOnce(Return(0));
+    EXPECT_EQ(0, event->run_batch(10, std::nullopt, timeout));
+}
+
+TEST_F(EventMethodTest, RunBatchExit)
+{
+    EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(1));
+    EXPECT_CALL(mock, sd_event_dispatch(expected_event)).WillOnce(Return(0));
+    EXPECT_EQ(1, event->run_batch(10, std::nullopt));
+}
+
+TEST_F(EventMethodTest, RunBatchInternalError)
+{
+    EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(1));
+    EXPECT_CALL(mock, sd_event_dispatch(expected_event))
+        .WillOnce(Return(-EINVAL));
+    EXPECT_THROW(event->run_batch(10, std::nullopt), SdEventError);
+}
+
+TEST_F(EventMethodTest, LoopBatch)
+{
+    const int user_code = 10;
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_dispatch(expected_event))
+            .WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(0));
+        EXPECT_CALL(mock, sd_event_wait(expected_event, 0)).WillOnce(Return(0));
+        EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(0));
+        EXPECT_CALL(mock,
+                    sd_event_wait(expected_event, static_cast<uint64_t>(-1)))
+            .WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_dispatch(expected_event))
+            .WillOnce(Return(0));
+        EXPECT_CALL(mock, sd_event_get_exit_code(expected_event, testing::_))
+            .WillOnce(DoAll(SetArgPointee<1>(user_code), Return(0)));
+    }
+    EXPECT_EQ(user_code, event->loop_batch(10, std::nullopt));
+}
+
+TEST_F(EventMethodTest, LoopBusyPollSpin)
+{
+    const int user_code = 10;
+    LoopProfile profile;
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(0));
+        EXPECT_CALL(mock,
+                    sd_event_wait(expected_event, static_cast<uint64_t>(-1)))
+            .WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_dispatch(expected_event))
+            .WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(0));
+        EXPECT_CALL(mock, sd_event_wait(expected_event, 0)).WillOnce(Return(0));
+        EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(0));
+        EXPECT_CALL(mock, sd_event_wait(expected_event, 0)).WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_dispatch(expected_event))
+            .WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_dispatch(expected_event))
+            .WillOnce(Return(0));
+        EXPECT_CALL(mock, sd_event_get_exit_code(expected_event, testing::_))
+            .WillOnce(DoAll(SetArgPointee<1>(user_code), Return(0)));
+    }
+    EXPECT_EQ(user_code,
+              event->loop_busy_poll(std::chrono::hours{1}, profile));
+    EXPECT_EQ(4, profile.iterations());
+    EXPECT_EQ(3, profile.dispatch.count());
+    EXPECT_EQ(2, profile.spins);
+    EXPECT_EQ(1, profile.parks);
+    EXPECT_DOUBLE_EQ(2.0 / 3, profile.spinRatio());
+}
+
+TEST_F(EventMethodTest, LoopBusyPollPark)
+{
+    const int user_code = 10;
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(0));
+        EXPECT_CALL(mock,
+                    sd_event_wait(expected_event, static_cast<uint64_t>(-1)))
+            .WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_dispatch(expected_event))
+            .WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_prepare(expected_event)).WillOnce(Return(0));
+        EXPECT_CALL(mock,
+                    sd_event_wait(expected_event, static_cast<uint64_t>(-1)))
+            .WillOnce(Return(1));
+        EXPECT_CALL(mock, sd_event_dispatch(expected_event))
+            .WillOnce(Return(0));
+        EXPECT_CALL(mock, sd_event_get_exit_code(expected_event, testing::_))
+            .WillOnce(DoAll(SetArgPointee<1>(user_code), Return(0)));
+    }
+    EXPECT_EQ(user_code, event->loop_busy_poll(Event::Timeout(0)));
+}
+
 TEST_F(EventMethodTest, LoopSuccess)
 {
     EXPECT_CALL(mock, sd_event_loop(expected_event)).WillOnce(Return(0));
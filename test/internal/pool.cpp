@@ -0,0 +1,93 @@
+#include <sdeventplus/internal/pool.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace sdeventplus
+{
+namespace internal
+{
+namespace
+{
+
+TEST(PoolTest, AllocateUsable)
+{
+    for (std::size_t size : {0, 1, 16, 17, 100, 256, 257, 4096})
+    {
+        void* ptr = pool_allocate(size);
+        ASSERT_NE(nullptr, ptr);
+        EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(ptr) %
+                         alignof(std::max_align_t));
+        std::memset(ptr, 0xa5, size);
+        pool_deallocate(ptr, size);
+    }
+}
+
+#ifndef SDEVENTPLUS_NO_SOURCE_POOL
+TEST(PoolTest, ReusesFreedBlocks)
+{
+    void* ptr = pool_allocate(100);
+    pool_deallocate(ptr, 100);
+    // Sizes in the same class share blocks
+    void* ptr2 = pool_allocate(97);
+    EXPECT_EQ(ptr, ptr2);
+    pool_deallocate(ptr2, 97);
+}
+
+TEST(PoolTest, ReusesManyBlocks)
+{
+    std::set<void*> blocks;
+    for (int i = 0; i < 64; ++i)
+    {
+        blocks.insert(pool_allocate(64));
+    }
+    for (void* ptr : blocks)
+    {
+        pool_deallocate(ptr, 64);
+    }
+    for (int i = 0; i < 64; ++i)
+    {
+        EXPECT_TRUE(blocks.contains(pool_allocate(64)));
+    }
+    for (void* ptr : blocks)
+    {
+        pool_deallocate(ptr, 64);
+    }
+}
+#endif
+
+TEST(PoolTest, FreeAfterThreadCache)
+{
+    std::thread([]() {
+        // Constructed before the cache, so destroyed after it
+        struct Holder
+        {
+            void* ptr = nullptr;
+
+            ~Holder()
+            {
+                pool_deallocate(ptr, 32);
+                pool_deallocate(pool_allocate(32), 32);
+            }
+        };
+        thread_local Holder holder;
+        holder.ptr = pool_allocate(32);
+    }).join();
+}
+
+TEST(PoolTest, CrossThreadFree)
+{
+    void* ptr = pool_allocate(48);
+    std::thread([&]() { pool_deallocate(ptr, 48); }).join();
+    void* large = pool_allocate(1 << 20);
+    std::thread([&]() { pool_deallocate(large, 1 << 20); }).join();
+}
+
+} // namespace
+} // namespace internal
+} // namespace sdeventplus
@@ -0,0 +1,121 @@
+#include <sdeventplus/profile.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+namespace sdeventplus
+{
+namespace
+{
+
+using std::chrono::nanoseconds;
+
+TEST(HistogramTest, Empty)
+{
+    Histogram h;
+    EXPECT_EQ(0, h.count());
+    EXPECT_EQ(nanoseconds(0), h.total());
+    EXPECT_EQ(nanoseconds(0), h.max());
+    EXPECT_EQ(nanoseconds(0), h.mean());
+    EXPECT_EQ(nanoseconds(0), h.percentile(0.5));
+}
+
+TEST(HistogramTest, Record)
+{
+    Histogram h;
+    h.record(nanoseconds(3));
+    h.record(nanoseconds(1000));
+    h.record(nanoseconds(-5));
+    EXPECT_EQ(3, h.count());
+    EXPECT_EQ(nanoseconds(1003), h.total());
+    EXPECT_EQ(nanoseconds(1000), h.max());
+    EXPECT_EQ(nanoseconds(334), h.mean());
+    EXPECT_EQ(1, h.bucketCount(0));
+    EXPECT_EQ(1, h.bucketCount(3));
+
+    h.reset();
+    EXPECT_EQ(0, h.count());
+    EXPECT_EQ(0, h.bucketCount(0));
+}
+
+TEST(HistogramTest, BucketsContiguous)
+{
+    // Every bucket must start right after the previous one ended, up to the
+    // largest duration representable in nanoseconds
+    for (size_t i = 1; i < 61 * Histogram::subBuckets; ++i)
+    {
+        uint64_t prev = Histogram::bucketMax(i - 1).count();
+        uint64_t cur = Histogram::bucketMax(i).count();
+        ASSERT_LT(prev, cur) << i;
+        Histogram h;
+        h.record(nanoseconds(prev + 1));
+        h.record(nanoseconds(cur));
+        ASSERT_EQ(2, h.bucketCount(i)) << i;
+    }
+}
+
+TEST(HistogramTest, BoundedError)
+{
+    for (uint64_t ns : {9ul, 100ul, 12345ul, 1000000ul, 987654321ul})
+    {
+        Histogram h;
+        h.record(nanoseconds(ns));
+        h.record(nanoseconds(ns * 4));
+        auto p = h.percentile(0.5).count();
+        EXPECT_GE(p, ns);
+        EXPECT_LE(p, ns + ns / Histogram::subBuckets);
+        EXPECT_EQ(nanoseconds(ns * 4), h.percentile(1));
+    }
+}
+
+TEST(HistogramTest, Percentile)
+{
+    Histogram h;
+    for (int i = 1; i <= 100; ++i)
+    {
+        h.record(nanoseconds(i));
+    }
+    EXPECT_EQ(nanoseconds(1), h.percentile(0));
+    EXPECT_EQ(nanoseconds(100), h.percentile(1));
+    EXPECT_EQ(nanoseconds(100), h.percentile(2));
+    auto p50 = h.percentile(0.5).count();
+    EXPECT_GE(p50, 50);
+    EXPECT_LE(p50, 50 + 50 / Histogram::subBuckets);
+}
+
+TEST(LoopProfileTest, Utilization)
+{
+    LoopProfile profile;
+    EXPECT_EQ(0, profile.iterations());
+    EXPECT_EQ(0, profile.utilization());
+
+    profile.prepare.record(nanoseconds(10));
+    profile.wait.record(nanoseconds(50));
+    profile.dispatch.record(nanoseconds(40));
+    profile.prepare.record(nanoseconds(0));
+    EXPECT_EQ(2, profile.iterations());
+    EXPECT_DOUBLE_EQ(0.5, profile.utilization());
+
+    profile.reset();
+    EXPECT_EQ(0, profile.iterations());
+    EXPECT_EQ(0, profile.utilization());
+}
+
+TEST(LoopProfileTest, SpinRatio)
+{
+    LoopProfile profile;
+    EXPECT_EQ(0, profile.spinRatio());
+    profile.spins = 3;
+    profile.parks = 1;
+    EXPECT_DOUBLE_EQ(0.75, profile.spinRatio());
+
+    profile.reset();
+    EXPECT_EQ(0, profile.spins);
+    EXPECT_EQ(0, profile.parks);
+}
+
+} // namespace
+} // namespace sdeventplus
@@ -8,10 +8,13 @@
 #include <sdeventplus/types.hpp>
 
 #include <cerrno>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <optional>
+#include <stdexcept>
 #include <string>
+#include <system_error>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -45,16 +48,40 @@ class BaseImpl : public Base
     {}
 
     using Base::get_prepare;
+    using Base::get_userdata;
+
+    using DispatchCallback = fu2::unique_function<void(BaseImpl&)>;
+    static int dispatchCallback(sd_event_source* source, void* userdata);
 };
 
 class BaseImplData : public BaseImpl, public detail::BaseData
 {
   public:
     BaseImplData(const BaseImpl& base) :
-        BaseImpl(base, sdeventplus::internal::NoOwn()), BaseData(base)
+        BaseImpl(base, sdeventplus::internal::NoOwn())
     {}
+
+    BaseImpl::DispatchCallback dispatch;
+
+    BaseImpl::DispatchCallback& get_dispatch()
+    {
+        return dispatch;
+    }
+
+  protected:
+    Base& get_source() override
+    {
+        return *this;
+    }
 };
 
+int BaseImpl::dispatchCallback(sd_event_source* source, void* userdata)
+{
+    return sourceCallback<DispatchCallback, BaseImplData,
+                          &BaseImplData::get_dispatch>("dispatchCallback",
+                                                       source, userdata);
+}
+
 BaseImpl::BaseImpl(const Event& event, sd_event_source* source,
                    std::false_type) : Base(event, source, std::false_type())
 {
@@ -203,7 +230,9 @@ TEST_F(BaseTest, UserdataOutlives)
 
     expect_base_destruct(*event, expected_source);
     source.reset();
-    EXPECT_FALSE(reinterpret_cast<BaseImpl*>(userdata)->get_prepare());
+    EXPECT_FALSE(
+        static_cast<BaseImplData*>(static_cast<detail::BaseData*>(userdata))
+            ->get_prepare());
     destroy(userdata);
 }
 
@@ -255,6 +284,12 @@ class BaseMethodTest : public BaseTest
         base.reset();
         destroy();
     }
+
+    int dispatch()
+    {
+        return BaseImpl::dispatchCallback(expected_source,
+                                          &base->get_userdata());
+    }
 };
 
 TEST_F(BaseMethodTest, GetDescriptionSuccess)
@@ -307,7 +342,7 @@ TEST_F(BaseMethodTest, SetPrepareCallback)
     EXPECT_FALSE(callback);
     EXPECT_FALSE(completed);
 
-    EXPECT_EQ(0, event_handler(nullptr, base.get()));
+    EXPECT_EQ(0, event_handler(nullptr, &base->get_userdata()));
     EXPECT_TRUE(completed);
 }
 
@@ -339,6 +374,18 @@ TEST_F(BaseMethodTest, SetPrepareError)
     EXPECT_TRUE(callback);
 }
 
+TEST_F(BaseMethodTest, SetPrepareErrorFresh)
+{
+    Base::Callback callback = [](Base&) {};
+    EXPECT_CALL(mock, sd_event_source_set_prepare(expected_source, testing::_))
+        .WillOnce(Return(-EINVAL));
+    EXPECT_THROW(base->set_prepare(std::move(callback)), SdEventError);
+    EXPECT_TRUE(callback);
+    EXPECT_FALSE(base->get_stats());
+    EXPECT_EQ(0u, base->get_throttled());
+    EXPECT_FALSE(base->get_prepare());
+}
+
 TEST_F(BaseMethodTest, SetPrepareNull)
 {
     EXPECT_CALL(mock, sd_event_source_set_prepare(expected_source, testing::_))
@@ -352,6 +399,142 @@ TEST_F(BaseMethodTest, SetPrepareNull)
     EXPECT_FALSE(base->get_prepare());
 }
 
+TEST_F(BaseMethodTest, SetRatelimit)
+{
+    sd_event_handler_t expire_handler;
+    EXPECT_CALL(mock, sd_event_source_set_ratelimit_expire_callback(
+                          expected_source, testing::_))
+        .WillOnce(DoAll(SaveArg<1>(&expire_handler), Return(0)));
+    EXPECT_CALL(mock,
+                sd_event_source_set_ratelimit(expected_source, 1000000, 10))
+        .WillOnce(Return(0));
+    base->set_ratelimit(Base::RateLimit{std::chrono::seconds{1}, 10});
+    EXPECT_EQ(0, base->get_throttled());
+
+    int expired = 0;
+    EXPECT_EQ(0, expire_handler(nullptr, &base->get_userdata()));
+    base->set_ratelimit_expire([&](Base&) { expired++; });
+    EXPECT_EQ(0, expire_handler(nullptr, &base->get_userdata()));
+    EXPECT_EQ(2, base->get_throttled());
+    EXPECT_EQ(1, expired);
+    EXPECT_EQ(-EINVAL, expire_handler(nullptr, nullptr));
+
+    EXPECT_CALL(mock, sd_event_source_set_ratelimit(expected_source, 0, 0))
+        .WillOnce(Return(0));
+    base->set_ratelimit(std::nullopt);
+}
+
+TEST_F(BaseMethodTest, SetRatelimitError)
+{
+    EXPECT_CALL(mock, sd_event_source_set_ratelimit_expire_callback(
+                          expected_source, testing::_))
+        .WillOnce(Return(0));
+    EXPECT_CALL(mock, sd_event_source_set_ratelimit(expected_source, 1000, 1))
+        .WillOnce(Return(-EDOM));
+    EXPECT_THROW(
+        base->set_ratelimit(Base::RateLimit{std::chrono::milliseconds{1}, 1}),
+        SdEventError);
+}
+
+TEST_F(BaseMethodTest, GetRatelimit)
+{
+    EXPECT_CALL(mock, sd_event_source_get_ratelimit(expected_source,
+                                                    testing::_, testing::_))
+        .WillOnce(Return(-ENOEXEC));
+    EXPECT_FALSE(base->get_ratelimit());
+
+    EXPECT_CALL(mock, sd_event_source_get_ratelimit(expected_source,
+                                                    testing::_, testing::_))
+        .WillOnce(DoAll(SetArgPointee<1>(2000), SetArgPointee<2>(5),
+                        Return(0)));
+    auto limit = base->get_ratelimit();
+    ASSERT_TRUE(limit);
+    EXPECT_EQ(std::chrono::milliseconds{2}, limit->interval);
+    EXPECT_EQ(5, limit->burst);
+
+    EXPECT_CALL(mock, sd_event_source_get_ratelimit(expected_source,
+                                                    testing::_, testing::_))
+        .WillOnce(Return(-EINVAL));
+    EXPECT_THROW(base->get_ratelimit(), SdEventError);
+}
+
+TEST_F(BaseMethodTest, IsRatelimited)
+{
+    EXPECT_CALL(mock, sd_event_source_is_ratelimited(expected_source))
+        .WillOnce(Return(1));
+    EXPECT_TRUE(base->is_ratelimited());
+    EXPECT_CALL(mock, sd_event_source_is_ratelimited(expected_source))
+        .WillOnce(Return(0));
+    EXPECT_FALSE(base->is_ratelimited());
+}
+
+TEST_F(BaseMethodTest, StatsDisabled)
+{
+    EXPECT_FALSE(base->get_stats());
+    base->set_stats(false);
+    EXPECT_FALSE(base->get_stats());
+}
+
+TEST_F(BaseMethodTest, StatsCollect)
+{
+    auto& data = static_cast<BaseImplData&>(base->get_userdata());
+    size_t calls = 0;
+    data.dispatch = [&](BaseImpl&) {
+        if (++calls == 2)
+        {
+            throw std::runtime_error("dispatch");
+        }
+    };
+
+    // Dispatches before collection is enabled are not counted
+    EXPECT_EQ(0, dispatch());
+    base->set_stats(true);
+    EXPECT_EQ(0, dispatch());
+    EXPECT_EQ(0, dispatch());
+    EXPECT_EQ(0, dispatch());
+    EXPECT_EQ(4, calls);
+
+    const char* expected = "test_desc";
+    EXPECT_CALL(mock,
+                sd_event_source_get_description(expected_source, testing::_))
+        .WillOnce(DoAll(SetArgPointee<1>(expected), Return(0)));
+    auto stats = base->get_stats();
+    ASSERT_TRUE(stats);
+    EXPECT_EQ(expected, stats->description);
+    EXPECT_EQ(3, stats->dispatches);
+    EXPECT_EQ(1, stats->exceptions);
+    EXPECT_LE(stats->max, stats->total);
+
+    // Enabling again keeps the counts
+    base->set_stats(true);
+    EXPECT_CALL(mock,
+                sd_event_source_get_description(expected_source, testing::_))
+        .WillOnce(Return(-ENXIO));
+    stats = base->get_stats();
+    ASSERT_TRUE(stats);
+    EXPECT_EQ("", stats->description);
+    EXPECT_EQ(3, stats->dispatches);
+
+    base->set_stats(false);
+    EXPECT_FALSE(base->get_stats());
+    base->set_stats(true);
+    EXPECT_CALL(mock,
+                sd_event_source_get_description(expected_source, testing::_))
+        .WillOnce(Return(-ENXIO));
+    stats = base->get_stats();
+    ASSERT_TRUE(stats);
+    EXPECT_EQ(0, stats->dispatches);
+}
+
+TEST_F(BaseMethodTest, StatsDisabledInCallback)
+{
+    auto& data = static_cast<BaseImplData&>(base->get_userdata());
+    data.dispatch = [&](BaseImpl& source) { source.set_stats(false); };
+    base->set_stats(true);
+    EXPECT_EQ(0, dispatch());
+    EXPECT_FALSE(base->get_stats());
+}
+
 TEST_F(BaseMethodTest, GetPendingSuccess)
 {
     EXPECT_CALL(mock, sd_event_source_get_pending(expected_source))
@@ -426,6 +609,60 @@ TEST_F(BaseMethodTest, SetEnabledError)
     EXPECT_THROW(base->set_enabled(Enabled::OneShot), SdEventError);
 }
 
+TEST_F(BaseMethodTest, TryGetEnabled)
+{
+    EXPECT_CALL(mock, sd_event_source_get_enabled(expected_source, testing::_))
+        .WillOnce(DoAll(SetArgPointee<1>(SD_EVENT_ONESHOT), Return(0)));
+    EXPECT_EQ(Enabled::OneShot, base->try_get_enabled());
+
+    EXPECT_CALL(mock, sd_event_source_get_enabled(expected_source, testing::_))
+        .WillOnce(Return(-EINVAL));
+    auto ret = base->try_get_enabled();
+    ASSERT_FALSE(ret);
+    EXPECT_EQ(std::errc::invalid_argument, ret.error());
+}
+
+TEST_F(BaseMethodTest, TrySetEnabled)
+{
+    EXPECT_CALL(mock, sd_event_source_set_enabled(expected_source, SD_EVENT_ON))
+        .WillOnce(Return(0));
+    EXPECT_TRUE(base->try_set_enabled(Enabled::On));
+
+    EXPECT_CALL(mock, sd_event_source_set_enabled(expected_source, SD_EVENT_OFF))
+        .WillOnce(Return(-EBUSY));
+    auto ret = base->try_set_enabled(Enabled::Off);
+    ASSERT_FALSE(ret);
+    EXPECT_EQ(std::errc::device_or_resource_busy, ret.error());
+}
+
+TEST_F(BaseMethodTest, TrySetPriority)
+{
+    EXPECT_CALL(mock, sd_event_source_set_priority(expected_source, 1024))
+        .WillOnce(Return(-EINVAL));
+    auto ret = base->try_set_priority(1024);
+    ASSERT_FALSE(ret);
+    EXPECT_EQ(std::errc::invalid_argument, ret.error());
+}
+
+TEST_F(BaseMethodTest, TryMovedFrom)
+{
+    BaseImpl mover(std::move(*base));
+    EXPECT_EQ(nullptr, base->get_or_null());
+    EXPECT_EQ(expected_source, mover.get_or_null());
+
+    auto priority = base->try_set_priority(1024);
+    ASSERT_FALSE(priority);
+    EXPECT_EQ(std::errc::bad_file_descriptor, priority.error());
+    auto get = base->try_get_enabled();
+    ASSERT_FALSE(get);
+    EXPECT_EQ(std::errc::bad_file_descriptor, get.error());
+    auto set = base->try_set_enabled(Enabled::On);
+    ASSERT_FALSE(set);
+    EXPECT_EQ(std::errc::bad_file_descriptor, set.error());
+
+    *base = std::move(mover);
+}
+
 TEST_F(BaseMethodTest, GetFloatingSuccess)
 {
     EXPECT_CALL(mock, sd_event_source_get_floating(expected_source))
@@ -125,6 +125,58 @@ TEST_F(ChildTest, ConstructError)
     EXPECT_EQ(0, completions);
 }
 
+TEST_F(ChildTest, ConstructPidFdSuccess)
+{
+    const int pidfd = 7;
+    const int options = WEXITED;
+
+    EXPECT_CALL(mock, sd_event_ref(expected_event))
+        .WillOnce(Return(expected_event));
+    sd_event_child_handler_t handler;
+    EXPECT_CALL(mock, sd_event_add_child_pidfd(expected_event, testing::_,
+                                               pidfd, options, testing::_,
+                                               nullptr))
+        .WillOnce(DoAll(SetArgPointee<1>(expected_source), SaveArg<4>(&handler),
+                        Return(0)));
+    sd_event_destroy_t destroy;
+    void* userdata;
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(mock, sd_event_source_set_destroy_callback(expected_source,
+                                                               testing::_))
+            .WillOnce(DoAll(SaveArg<1>(&destroy), Return(0)));
+        EXPECT_CALL(mock,
+                    sd_event_source_set_userdata(expected_source, testing::_))
+            .WillOnce(DoAll(SaveArg<1>(&userdata), Return(nullptr)));
+        EXPECT_CALL(mock, sd_event_source_get_userdata(expected_source))
+            .WillRepeatedly(ReturnPointee(&userdata));
+    }
+    int completions = 0;
+    Child child(*event, PidFd{pidfd}, options,
+                [&](Child&, const siginfo_t*) { completions++; });
+
+    EXPECT_EQ(0, handler(nullptr, nullptr, userdata));
+    EXPECT_EQ(1, completions);
+
+    expect_destruct();
+    destroy(userdata);
+}
+
+TEST_F(ChildTest, ConstructPidFdError)
+{
+    const int pidfd = 7;
+    const int options = WEXITED;
+
+    EXPECT_CALL(mock, sd_event_add_child_pidfd(expected_event, testing::_,
+                                               pidfd, options, testing::_,
+                                               nullptr))
+        .WillOnce(Return(-EBADF));
+    Child::Callback callback = [](Child&, const siginfo_t*) {};
+    EXPECT_THROW(Child(*event, PidFd{pidfd}, options, std::move(callback)),
+                 SdEventError);
+    EXPECT_TRUE(callback);
+}
+
 class ChildMethodTest : public ChildTest
 {
   protected:
@@ -215,6 +267,54 @@ TEST_F(ChildMethodTest, GetPidError)
     EXPECT_THROW(child->get_pid(), SdEventError);
 }
 
+TEST_F(ChildMethodTest, GetPidFd)
+{
+    EXPECT_CALL(mock, sd_event_source_get_child_pidfd(expected_source))
+        .WillOnce(Return(9))
+        .WillOnce(Return(-EOPNOTSUPP));
+    EXPECT_EQ(9, child->get_pidfd());
+    EXPECT_THROW(child->get_pidfd(), SdEventError);
+}
+
+TEST_F(ChildMethodTest, PidFdOwn)
+{
+    EXPECT_CALL(mock, sd_event_source_set_child_pidfd_own(expected_source, 1))
+        .WillOnce(Return(0));
+    child->set_pidfd_own(true);
+
+    EXPECT_CALL(mock, sd_event_source_get_child_pidfd_own(expected_source))
+        .WillOnce(Return(1))
+        .WillOnce(Return(-ENOSYS));
+    EXPECT_TRUE(child->get_pidfd_own());
+    EXPECT_THROW(child->get_pidfd_own(), SdEventError);
+}
+
+TEST_F(ChildMethodTest, ProcessOwn)
+{
+    EXPECT_CALL(mock,
+                sd_event_source_set_child_process_own(expected_source, 0))
+        .WillOnce(Return(-EINVAL));
+    EXPECT_THROW(child->set_process_own(false), SdEventError);
+
+    EXPECT_CALL(mock, sd_event_source_get_child_process_own(expected_source))
+        .WillOnce(Return(0));
+    EXPECT_FALSE(child->get_process_own());
+}
+
+TEST_F(ChildMethodTest, SendSignal)
+{
+    siginfo_t si{};
+    EXPECT_CALL(mock, sd_event_source_send_child_signal(expected_source,
+                                                        SIGTERM, nullptr, 0))
+        .WillOnce(Return(0));
+    child->send_signal(SIGTERM);
+
+    EXPECT_CALL(mock, sd_event_source_send_child_signal(expected_source,
+                                                        SIGUSR1, &si, 0))
+        .WillOnce(Return(-ESRCH));
+    EXPECT_THROW(child->send_signal(SIGUSR1, &si), SdEventError);
+}
+
 } // namespace
 } // namespace source
 } // namespace sdeventplus
@@ -6,8 +6,10 @@
 #include <sdeventplus/test/sdevent.hpp>
 
 #include <cerrno>
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <system_error>
 #include <type_traits>
 #include <utility>
 
@@ -175,6 +177,77 @@ TEST_F(EventTest, ExitConstruct)
     destroy(userdata);
 }
 
+TEST_F(EventTest, MemoryPressureConstruct)
+{
+    EXPECT_CALL(mock, sd_event_ref(expected_event))
+        .WillOnce(Return(expected_event));
+    sd_event_destroy_t destroy;
+    void* userdata;
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(mock, sd_event_source_set_destroy_callback(expected_source,
+                                                               testing::_))
+            .WillOnce(DoAll(SaveArg<1>(&destroy), Return(0)));
+        EXPECT_CALL(mock,
+                    sd_event_source_set_userdata(expected_source, testing::_))
+            .WillOnce(DoAll(SaveArg<1>(&userdata), Return(nullptr)));
+        EXPECT_CALL(mock, sd_event_source_get_userdata(expected_source))
+            .WillRepeatedly(ReturnPointee(&userdata));
+    }
+    sd_event_handler_t handler;
+    EXPECT_CALL(mock, sd_event_add_memory_pressure(expected_event, testing::_,
+                                                   testing::_, nullptr))
+        .WillOnce(DoAll(SetArgPointee<1>(expected_source), SaveArg<2>(&handler),
+                        Return(0)));
+    int completions = 0;
+    EventBase::Callback callback = [&completions](EventBase&) {
+        completions++;
+    };
+    MemoryPressure pressure(*event, std::move(callback));
+    EXPECT_NE(&pressure, userdata);
+    EXPECT_FALSE(callback);
+    EXPECT_EQ(0, completions);
+
+    EXPECT_CALL(mock, sd_event_source_set_memory_pressure_type(expected_source,
+                                                               testing::StrEq(
+                                                                   "full")))
+        .WillOnce(Return(0));
+    pressure.set_type("full");
+    EXPECT_CALL(mock, sd_event_source_set_memory_pressure_period(
+                          expected_source, 100000, 2000000))
+        .WillOnce(Return(0));
+    pressure.set_period(std::chrono::milliseconds(100),
+                        std::chrono::seconds(2));
+    EXPECT_CALL(mock, sd_event_source_set_memory_pressure_period(
+                          expected_source, 0, 0))
+        .WillOnce(Return(-EINVAL));
+    EXPECT_THROW(pressure.set_period(SdEventDuration::zero(),
+                                     SdEventDuration::zero()),
+                 SdEventError);
+
+    EXPECT_EQ(0, handler(nullptr, userdata));
+    EXPECT_EQ(1, completions);
+
+    expect_destruct();
+    destroy(userdata);
+}
+
+TEST_F(EventTest, MemoryPressureUnsupported)
+{
+    EXPECT_CALL(mock, sd_event_add_memory_pressure(expected_event, testing::_,
+                                                   testing::_, nullptr))
+        .WillOnce(Return(-EOPNOTSUPP));
+    try
+    {
+        MemoryPressure(*event, [](EventBase&) {});
+        FAIL() << "Expected an SdEventError";
+    }
+    catch (const SdEventError& e)
+    {
+        EXPECT_EQ(std::errc::operation_not_supported, e.code());
+    }
+}
+
 TEST_F(EventTest, ConstructFailure)
 {
     EXPECT_CALL(mock, sd_event_add_defer(expected_event, testing::_, testing::_,
@@ -0,0 +1,375 @@
+#include <sys/inotify.h>
+#include <systemd/sd-event.h>
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/exception.hpp>
+#include <sdeventplus/source/inotify.hpp>
+#include <sdeventplus/test/sdevent.hpp>
+
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace sdeventplus
+{
+namespace source
+{
+namespace
+{
+
+using testing::DoAll;
+using testing::Return;
+using testing::ReturnPointee;
+using testing::SaveArg;
+using testing::SetArgPointee;
+
+using UniqueEvent = std::unique_ptr<Event, std::function<void(Event*)>>;
+
+class InotifyTest : public testing::Test
+{
+  protected:
+    testing::StrictMock<test::SdEventMock> mock;
+    sd_event_source* const expected_source =
+        reinterpret_cast<sd_event_source*>(1234);
+    sd_event* const expected_event = reinterpret_cast<sd_event*>(2345);
+    UniqueEvent event = make_event(expected_event);
+
+    UniqueEvent make_event(sd_event* event)
+    {
+        auto deleter = [this, event](Event* e) {
+            EXPECT_CALL(this->mock, sd_event_unref(event))
+                .WillOnce(Return(nullptr));
+            delete e;
+        };
+        return UniqueEvent(new Event(event, std::false_type(), &mock), deleter);
+    }
+
+    void expect_destruct()
+    {
+        EXPECT_CALL(mock, sd_event_source_unref(expected_source))
+            .WillOnce(Return(nullptr));
+        EXPECT_CALL(mock, sd_event_unref(expected_event))
+            .WillOnce(Return(nullptr));
+    }
+};
+
+TEST_F(InotifyTest, ConstructSuccess)
+{
+    const char* path = "/etc/sensors.conf";
+    const uint32_t mask = IN_MODIFY | IN_DELETE_SELF;
+
+    EXPECT_CALL(mock, sd_event_ref(expected_event))
+        .WillOnce(Return(expected_event));
+    sd_event_inotify_handler_t handler;
+    EXPECT_CALL(mock, sd_event_add_inotify(expected_event, testing::_, path,
+                                           mask, testing::_, nullptr))
+        .WillOnce(DoAll(SetArgPointee<1>(expected_source), SaveArg<4>(&handler),
+                        Return(0)));
+    sd_event_destroy_t destroy;
+    void* userdata;
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(mock, sd_event_source_set_destroy_callback(expected_source,
+                                                               testing::_))
+            .WillOnce(DoAll(SaveArg<1>(&destroy), Return(0)));
+        EXPECT_CALL(mock,
+                    sd_event_source_set_userdata(expected_source, testing::_))
+            .WillOnce(DoAll(SaveArg<1>(&userdata), Return(nullptr)));
+        EXPECT_CALL(mock, sd_event_source_get_userdata(expected_source))
+            .WillRepeatedly(ReturnPointee(&userdata));
+    }
+    int completions = 0;
+    const struct inotify_event* return_event;
+    Inotify::Callback callback = [&](Inotify&,
+                                     const struct inotify_event* event) {
+        return_event = event;
+        completions++;
+    };
+    Inotify inotify(*event, path, mask, std::move(callback));
+    EXPECT_FALSE(callback);
+    EXPECT_NE(&inotify, userdata);
+    EXPECT_EQ(0, completions);
+
+    const struct inotify_event* expected_ievent =
+        reinterpret_cast<struct inotify_event*>(865);
+    EXPECT_EQ(0, handler(nullptr, expected_ievent, userdata));
+    EXPECT_EQ(1, completions);
+    EXPECT_EQ(expected_ievent, return_event);
+
+    inotify.set_callback(std::bind([]() {}));
+    EXPECT_EQ(0, handler(nullptr, expected_ievent, userdata));
+    EXPECT_EQ(1, completions);
+
+    expect_destruct();
+    destroy(userdata);
+}
+
+TEST_F(InotifyTest, ConstructFdSuccess)
+{
+    const int fd = 10;
+    const uint32_t mask = IN_CLOSE_WRITE;
+
+    EXPECT_CALL(mock, sd_event_ref(expected_event))
+        .WillOnce(Return(expected_event));
+    EXPECT_CALL(mock, sd_event_add_inotify_fd(expected_event, testing::_, fd,
+                                              mask, testing::_, nullptr))
+        .WillOnce(DoAll(SetArgPointee<1>(expected_source), Return(0)));
+    sd_event_destroy_t destroy;
+    void* userdata;
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(mock, sd_event_source_set_destroy_callback(expected_source,
+                                                               testing::_))
+            .WillOnce(DoAll(SaveArg<1>(&destroy), Return(0)));
+        EXPECT_CALL(mock,
+                    sd_event_source_set_userdata(expected_source, testing::_))
+            .WillOnce(DoAll(SaveArg<1>(&userdata), Return(nullptr)));
+    }
+    Inotify inotify(*event, fd, mask,
+                    [](Inotify&, const struct inotify_event*) {});
+    EXPECT_EQ(expected_source, inotify.get());
+
+    expect_destruct();
+    destroy(userdata);
+}
+
+TEST_F(InotifyTest, ConstructError)
+{
+    const char* path = "/etc/sensors.conf";
+    const uint32_t mask = IN_MODIFY;
+
+    EXPECT_CALL(mock, sd_event_add_inotify(expected_event, testing::_, path,
+                                           mask, testing::_, nullptr))
+        .WillOnce(Return(-ENOENT));
+    int completions = 0;
+    Inotify::Callback callback =
+        [&completions](Inotify&, const struct inotify_event*) {
+            completions++;
+        };
+    EXPECT_THROW(Inotify(*event, path, mask, std::move(callback)),
+                 SdEventError);
+    EXPECT_TRUE(callback);
+    EXPECT_EQ(0, completions);
+}
+
+TEST_F(InotifyTest, ConstructFdError)
+{
+    EXPECT_CALL(mock, sd_event_add_inotify_fd(expected_event, testing::_, -1,
+                                              IN_MODIFY, testing::_, nullptr))
+        .WillOnce(Return(-EBADF));
+    EXPECT_THROW(Inotify(*event, -1, IN_MODIFY,
+                         [](Inotify&, const struct inotify_event*) {}),
+                 SdEventError);
+}
+
+class InotifyMethodTest : public InotifyTest
+{
+  protected:
+    std::unique_ptr<Inotify> inotify;
+    sd_event_inotify_handler_t handler;
+    sd_event_destroy_t destroy;
+    void* userdata;
+    std::vector<std::pair<uint32_t, std::string>> seen;
+
+    void SetUp()
+    {
+        EXPECT_CALL(mock, sd_event_ref(expected_event))
+            .WillOnce(Return(expected_event));
+        EXPECT_CALL(mock, sd_event_add_inotify(expected_event, testing::_,
+                                               testing::_, IN_ALL_EVENTS,
+                                               testing::_, nullptr))
+            .WillOnce(DoAll(SetArgPointee<1>(expected_source),
+                            SaveArg<4>(&handler), Return(0)));
+        {
+            testing::InSequence seq;
+            EXPECT_CALL(mock, sd_event_source_set_destroy_callback(
+                                  expected_source, testing::_))
+                .WillOnce(DoAll(SaveArg<1>(&destroy), Return(0)));
+            EXPECT_CALL(
+                mock, sd_event_source_set_userdata(expected_source, testing::_))
+                .WillOnce(DoAll(SaveArg<1>(&userdata), Return(nullptr)));
+            EXPECT_CALL(mock, sd_event_source_get_userdata(expected_source))
+                .WillRepeatedly(ReturnPointee(&userdata));
+        }
+        inotify = std::make_unique<Inotify>(
+            *event, "/etc", IN_ALL_EVENTS,
+            [this](Inotify&, const struct inotify_event* event) {
+                seen.emplace_back(event->mask,
+                                  event->len > 0 ? event->name : "");
+            });
+    }
+
+    void TearDown()
+    {
+        if (inotify)
+        {
+            expect_destruct();
+            inotify.reset();
+            destroy(userdata);
+        }
+    }
+
+    int notify(uint32_t mask, const char* name)
+    {
+        alignas(struct inotify_event) char
+            buf[sizeof(struct inotify_event) + NAME_MAX + 1] = {};
+        auto event = reinterpret_cast<struct inotify_event*>(buf);
+        event->wd = 1;
+        event->mask = mask;
+        event->len = strlen(name) + 1;
+        strcpy(event->name, name);
+        return handler(expected_source, event, userdata);
+    }
+};
+
+TEST_F(InotifyMethodTest, Copy)
+{
+    EXPECT_CALL(mock, sd_event_ref(expected_event))
+        .WillOnce(Return(expected_event));
+    EXPECT_CALL(mock, sd_event_source_ref(expected_source))
+        .WillOnce(Return(expected_source));
+    auto inotify2 = std::make_unique<Inotify>(*inotify);
+
+    // Delete the original inotify
+    inotify2.swap(inotify);
+    expect_destruct();
+    inotify2.reset();
+
+    // Make sure our new copy can still access data
+    inotify->set_callback(nullptr);
+}
+
+TEST_F(InotifyMethodTest, GetMaskSuccess)
+{
+    EXPECT_CALL(mock, sd_event_source_get_inotify_mask(expected_source,
+                                                       testing::_))
+        .WillOnce(DoAll(SetArgPointee<1>(IN_ALL_EVENTS), Return(0)));
+    EXPECT_EQ(IN_ALL_EVENTS, inotify->get_mask());
+}
+
+TEST_F(InotifyMethodTest, GetMaskError)
+{
+    EXPECT_CALL(mock, sd_event_source_get_inotify_mask(expected_source,
+                                                       testing::_))
+        .WillOnce(Return(-EINVAL));
+    EXPECT_THROW(inotify->get_mask(), SdEventError);
+}
+
+TEST_F(InotifyMethodTest, NoCoalesce)
+{
+    EXPECT_FALSE(inotify->get_coalesce());
+    EXPECT_EQ(0, notify(IN_MODIFY, "a.conf"));
+    EXPECT_EQ(0, notify(IN_MODIFY, "a.conf"));
+    EXPECT_EQ(2, seen.size());
+    EXPECT_EQ(0, inotify->get_coalesced());
+}
+
+TEST_F(InotifyMethodTest, Coalesce)
+{
+    sd_event_source* const timer_source =
+        reinterpret_cast<sd_event_source*>(3456);
+    inotify->set_coalesce(std::chrono::milliseconds(100));
+    EXPECT_EQ(std::chrono::milliseconds(100), *inotify->get_coalesce());
+
+    // The first modification opens the window
+    EXPECT_CALL(mock, sd_event_now(expected_event, CLOCK_MONOTONIC, testing::_))
+        .WillOnce(DoAll(SetArgPointee<2>(1000000), Return(0)));
+    EXPECT_CALL(mock, sd_event_ref(expected_event))
+        .WillOnce(Return(expected_event));
+    sd_event_time_handler_t timer_handler;
+    EXPECT_CALL(mock,
+                sd_event_add_time(expected_event, testing::_, CLOCK_MONOTONIC,
+                                  1100000, 1000, testing::_, nullptr))
+        .WillOnce(DoAll(SetArgPointee<1>(timer_source),
+                        SaveArg<5>(&timer_handler), Return(0)));
+    sd_event_destroy_t timer_destroy;
+    void* timer_userdata;
+    EXPECT_CALL(mock, sd_event_source_get_userdata(timer_source))
+        .WillRepeatedly(ReturnPointee(&timer_userdata));
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(mock, sd_event_source_set_destroy_callback(timer_source,
+                                                               testing::_))
+            .WillOnce(DoAll(SaveArg<1>(&timer_destroy), Return(0)));
+        EXPECT_CALL(mock,
+                    sd_event_source_set_userdata(timer_source, testing::_))
+            .WillOnce(DoAll(SaveArg<1>(&timer_userdata), Return(nullptr)));
+        EXPECT_CALL(mock,
+                    sd_event_source_set_enabled(timer_source, SD_EVENT_ONESHOT))
+            .WillOnce(Return(0));
+    }
+    EXPECT_EQ(0, notify(IN_MODIFY, "a.conf"));
+    EXPECT_EQ(0, seen.size());
+
+    // Further modifications are merged
+    EXPECT_EQ(0, notify(IN_MODIFY, "a.conf"));
+    EXPECT_EQ(0, notify(IN_MODIFY, "a.conf"));
+    EXPECT_EQ(0, seen.size());
+    EXPECT_EQ(2, inotify->get_coalesced());
+
+    // Other events are not merged
+    EXPECT_EQ(0, notify(IN_CREATE, "b.conf"));
+    ASSERT_EQ(1, seen.size());
+    EXPECT_EQ(IN_CREATE, seen[0].first);
+
+    // The merged modification is dispatched once the window elapsed
+    EXPECT_CALL(mock, sd_event_ref(expected_event))
+        .WillOnce(Return(expected_event));
+    EXPECT_CALL(mock, sd_event_source_ref(expected_source))
+        .WillOnce(Return(expected_source));
+    EXPECT_CALL(mock, sd_event_source_set_enabled(timer_source, SD_EVENT_OFF))
+        .WillOnce(Return(0));
+    expect_destruct();
+    EXPECT_EQ(0, timer_handler(timer_source, 1100000, timer_userdata));
+    ASSERT_EQ(2, seen.size());
+    EXPECT_EQ(IN_MODIFY, seen[1].first);
+    EXPECT_EQ("a.conf", seen[1].second);
+    EXPECT_EQ(2, inotify->get_coalesced());
+
+    // A merged modification is dispatched ahead of other events on the path
+    EXPECT_CALL(mock, sd_event_now(expected_event, CLOCK_MONOTONIC, testing::_))
+        .WillOnce(DoAll(SetArgPointee<2>(2000000), Return(0)));
+    EXPECT_CALL(mock, sd_event_source_set_time(timer_source, 2100000))
+        .WillOnce(Return(0));
+    EXPECT_CALL(mock,
+                sd_event_source_set_enabled(timer_source, SD_EVENT_ONESHOT))
+        .WillOnce(Return(0));
+    EXPECT_EQ(0, notify(IN_MODIFY, "a.conf"));
+    EXPECT_CALL(mock, sd_event_source_set_enabled(timer_source, SD_EVENT_OFF))
+        .WillOnce(Return(0));
+    EXPECT_EQ(0, notify(IN_DELETE, "a.conf"));
+    ASSERT_EQ(4, seen.size());
+    EXPECT_EQ(IN_MODIFY, seen[2].first);
+    EXPECT_EQ(IN_DELETE, seen[3].first);
+
+    // Disabling merging dispatches every modification again
+    inotify->set_coalesce(std::nullopt);
+    EXPECT_FALSE(inotify->get_coalesce());
+    EXPECT_EQ(0, notify(IN_MODIFY, "a.conf"));
+    EXPECT_EQ(5, seen.size());
+
+    // The time source goes away with the inotify source
+    expect_destruct();
+    inotify.reset();
+    EXPECT_CALL(mock, sd_event_source_unref(timer_source))
+        .WillOnce(Return(nullptr));
+    EXPECT_CALL(mock, sd_event_unref(expected_event))
+        .WillOnce(Return(nullptr));
+    destroy(userdata);
+    timer_destroy(timer_userdata);
+}
+
+} // namespace
+} // namespace source
+} // namespace sdeventplus
@@ -1,4 +1,6 @@
+#include <fcntl.h>
 #include <systemd/sd-event.h>
+#include <unistd.h>
 
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/exception.hpp>
@@ -6,10 +8,15 @@
 #include <sdeventplus/test/sdevent.hpp>
 
 #include <cerrno>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <stdexcept>
+#include <system_error>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -125,6 +132,157 @@ TEST_F(IOTest, ConstructError)
     EXPECT_EQ(0, completions);
 }
 
+TEST_F(IOTest, StaticConstructSuccess)
+{
+    const int fd = 10;
+    const uint32_t events = EPOLLIN;
+
+    EXPECT_CALL(mock, sd_event_ref(expected_event))
+        .WillOnce(Return(expected_event));
+    sd_event_io_handler_t handler;
+    EXPECT_CALL(mock, sd_event_add_io(expected_event, testing::_, fd, events,
+                                      testing::_, nullptr))
+        .WillOnce(DoAll(SetArgPointee<1>(expected_source), SaveArg<4>(&handler),
+                        Return(0)));
+    sd_event_destroy_t destroy;
+    void* userdata;
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(mock, sd_event_source_set_destroy_callback(expected_source,
+                                                               testing::_))
+            .WillOnce(DoAll(SaveArg<1>(&destroy), Return(0)));
+        EXPECT_CALL(mock,
+                    sd_event_source_set_userdata(expected_source, testing::_))
+            .WillOnce(DoAll(SaveArg<1>(&userdata), Return(nullptr)));
+        EXPECT_CALL(mock, sd_event_source_get_userdata(expected_source))
+            .WillRepeatedly(ReturnPointee(&userdata));
+    }
+    struct Callback
+    {
+        int* completions;
+        int* return_fd;
+
+        void operator()(IO&, int fd, uint32_t)
+        {
+            *return_fd = fd;
+            (*completions)++;
+        }
+    };
+    int completions = 0;
+    int return_fd;
+    StaticIO io(*event, fd, events, Callback{&completions, &return_fd});
+    EXPECT_NE(&io, userdata);
+
+    EXPECT_EQ(0, handler(nullptr, 5, EPOLLIN, userdata));
+    EXPECT_EQ(1, completions);
+    EXPECT_EQ(5, return_fd);
+
+    int other_completions = 0;
+    io.set_callback(Callback{&other_completions, &return_fd});
+    EXPECT_EQ(0, handler(nullptr, 6, EPOLLIN, userdata));
+    EXPECT_EQ(1, completions);
+    EXPECT_EQ(1, other_completions);
+    EXPECT_EQ(6, return_fd);
+
+    // The type erased callback setter can not store into the static userdata
+    IO& base = io;
+    EXPECT_THROW(base.set_callback([](IO&, int, uint32_t) {}),
+                 std::runtime_error);
+    EXPECT_EQ(0, handler(nullptr, 7, EPOLLIN, userdata));
+    EXPECT_EQ(2, other_completions);
+
+    expect_destruct();
+    destroy(userdata);
+}
+
+TEST_F(IOTest, StaticSetCapturingCallback)
+{
+    EXPECT_CALL(mock, sd_event_ref(expected_event))
+        .WillOnce(Return(expected_event));
+    sd_event_io_handler_t handler;
+    EXPECT_CALL(mock, sd_event_add_io(expected_event, testing::_, 10, EPOLLIN,
+                                      testing::_, nullptr))
+        .WillOnce(DoAll(SetArgPointee<1>(expected_source), SaveArg<4>(&handler),
+                        Return(0)));
+    sd_event_destroy_t destroy;
+    void* userdata;
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(mock, sd_event_source_set_destroy_callback(expected_source,
+                                                               testing::_))
+            .WillOnce(DoAll(SaveArg<1>(&destroy), Return(0)));
+        EXPECT_CALL(mock,
+                    sd_event_source_set_userdata(expected_source, testing::_))
+            .WillOnce(DoAll(SaveArg<1>(&userdata), Return(nullptr)));
+        EXPECT_CALL(mock, sd_event_source_get_userdata(expected_source))
+            .WillRepeatedly(ReturnPointee(&userdata));
+    }
+    // Capturing lambdas have a deleted copy assignment
+    auto make_callback = [](int* out) {
+        return [out](IO&, int fd, uint32_t) { *out = fd; };
+    };
+    int first = 0, second = 0;
+    StaticIO io(*event, 10, EPOLLIN, make_callback(&first));
+
+    EXPECT_EQ(0, handler(nullptr, 5, EPOLLIN, userdata));
+    EXPECT_EQ(5, first);
+
+    io.set_callback(make_callback(&second));
+    EXPECT_EQ(0, handler(nullptr, 6, EPOLLIN, userdata));
+    EXPECT_EQ(5, first);
+    EXPECT_EQ(6, second);
+
+    expect_destruct();
+    destroy(userdata);
+}
+
+TEST_F(IOTest, StaticOverAligned)
+{
+    EXPECT_CALL(mock, sd_event_ref(expected_event))
+        .WillOnce(Return(expected_event));
+    sd_event_io_handler_t handler;
+    EXPECT_CALL(mock, sd_event_add_io(expected_event, testing::_, 10, EPOLLIN,
+                                      testing::_, nullptr))
+        .WillOnce(DoAll(SetArgPointee<1>(expected_source), SaveArg<4>(&handler),
+                        Return(0)));
+    sd_event_destroy_t destroy;
+    void* userdata;
+    EXPECT_CALL(mock, sd_event_source_set_destroy_callback(expected_source,
+                                                           testing::_))
+        .WillOnce(DoAll(SaveArg<1>(&destroy), Return(0)));
+    EXPECT_CALL(mock, sd_event_source_set_userdata(expected_source, testing::_))
+        .WillOnce(DoAll(SaveArg<1>(&userdata), Return(nullptr)));
+    struct alignas(128) Callback
+    {
+        std::uintptr_t* addr;
+
+        void operator()(IO&, int, uint32_t)
+        {
+            *addr = reinterpret_cast<std::uintptr_t>(this);
+        }
+    };
+    std::uintptr_t addr = 1;
+    StaticIO io(*event, 10, EPOLLIN, Callback{&addr});
+    EXPECT_EQ(0, handler(nullptr, 10, EPOLLIN, userdata));
+    // Over-aligned userdata does not come from the pool
+    EXPECT_EQ(0, addr % 128);
+
+    expect_destruct();
+    destroy(userdata);
+}
+
+TEST_F(IOTest, StaticConstructError)
+{
+    const int fd = 10;
+    const uint32_t events = EPOLLIN;
+
+    EXPECT_CALL(mock, sd_event_add_io(expected_event, testing::_, fd, events,
+                                      testing::_, nullptr))
+        .WillOnce(Return(-EINVAL));
+    EXPECT_THROW(StaticIO(*event, fd, events, [](IO&, int, uint32_t) {}),
+                 SdEventError);
+}
+
 class IOMethodTest : public IOTest
 {
   protected:
@@ -262,6 +420,18 @@ TEST_F(IOMethodTest, SetEventsError)
     EXPECT_THROW(io->set_events(events), SdEventError);
 }
 
+TEST_F(IOMethodTest, TryMovedFrom)
+{
+    IO moved(std::move(*io));
+    auto fd = io->try_set_fd(5);
+    ASSERT_FALSE(fd);
+    EXPECT_EQ(std::errc::bad_file_descriptor, fd.error());
+    auto events = io->try_set_events(EPOLLIN);
+    ASSERT_FALSE(events);
+    EXPECT_EQ(std::errc::bad_file_descriptor, events.error());
+    *io = std::move(moved);
+}
+
 TEST_F(IOMethodTest, GetREventsSuccess)
 {
     const uint32_t revents = EPOLLOUT;
@@ -279,6 +449,244 @@ TEST_F(IOMethodTest, GetREventsError)
     EXPECT_THROW(io->get_revents(), SdEventError);
 }
 
+class DrainIOTest : public IOTest
+{
+  protected:
+    int fds[2];
+    std::unique_ptr<DrainIO> io;
+    sd_event_io_handler_t handler;
+    sd_event_destroy_t destroy;
+    void* userdata;
+    std::function<void(DrainIO::Reader&)> body;
+
+    void SetUp()
+    {
+        ASSERT_EQ(0, pipe2(fds, O_NONBLOCK | O_CLOEXEC));
+
+        EXPECT_CALL(mock, sd_event_ref(expected_event))
+            .WillOnce(Return(expected_event));
+        EXPECT_CALL(mock,
+                    sd_event_add_io(expected_event, testing::_, fds[0],
+                                    EPOLLIN | EPOLLET, testing::_, nullptr))
+            .WillOnce(DoAll(SetArgPointee<1>(expected_source),
+                            SaveArg<4>(&handler), Return(0)));
+        {
+            testing::InSequence seq;
+            EXPECT_CALL(mock, sd_event_source_set_destroy_callback(
+                                  expected_source, testing::_))
+                .WillOnce(DoAll(SaveArg<1>(&destroy), Return(0)));
+            EXPECT_CALL(
+                mock, sd_event_source_set_userdata(expected_source, testing::_))
+                .WillOnce(DoAll(SaveArg<1>(&userdata), Return(nullptr)));
+            EXPECT_CALL(mock, sd_event_source_get_userdata(expected_source))
+                .WillRepeatedly(ReturnPointee(&userdata));
+        }
+        io = std::make_unique<DrainIO>(
+            *event, fds[0], EPOLLIN,
+            [this](DrainIO&, DrainIO::Reader& reader, uint32_t) {
+                body(reader);
+            });
+    }
+
+    void TearDown()
+    {
+        if (io)
+        {
+            expect_destruct();
+            io.reset();
+        }
+        destroy(userdata);
+        close(fds[0]);
+        if (fds[1] >= 0)
+        {
+            close(fds[1]);
+        }
+    }
+
+    void fill(size_t len)
+    {
+        std::vector<char> buf(len, 'a');
+        ASSERT_EQ(static_cast<ssize_t>(len), write(fds[1], buf.data(), len));
+    }
+
+    void expect_attached(sd_event* attached)
+    {
+        EXPECT_CALL(mock, sd_event_source_get_event(expected_source))
+            .WillOnce(Return(attached));
+    }
+};
+
+TEST_F(DrainIOTest, Drained)
+{
+    fill(10000);
+    size_t reads = 0;
+    bool drained = false;
+    size_t bytes = 0;
+    body = [&](DrainIO::Reader& reader) {
+        char buf[4096];
+        while (reader.read(buf, sizeof(buf)) > 0)
+        {
+            reads++;
+        }
+        drained = reader.drained();
+        bytes = reader.get_bytes();
+        EXPECT_FALSE(reader.eof());
+        EXPECT_EQ(0u, reader.read(buf, sizeof(buf)));
+    };
+    EXPECT_EQ(0, handler(nullptr, fds[0], EPOLLIN, userdata));
+    EXPECT_EQ(3u, reads);
+    EXPECT_TRUE(drained);
+    EXPECT_EQ(10000u, bytes);
+    EXPECT_EQ(0u, io->get_rearms());
+
+    IO& base = *io;
+    EXPECT_THROW(base.set_callback([](IO&, int, uint32_t) {}),
+                 std::runtime_error);
+}
+
+TEST_F(DrainIOTest, Eof)
+{
+    fill(10);
+    close(fds[1]);
+    fds[1] = -1;
+    bool eof = false;
+    body = [&](DrainIO::Reader& reader) {
+        char buf[64];
+        EXPECT_EQ(10u, reader.read(buf, sizeof(buf)));
+        EXPECT_EQ(0u, reader.read(buf, sizeof(buf)));
+        eof = reader.eof();
+    };
+    EXPECT_EQ(0, handler(nullptr, fds[0], EPOLLIN | EPOLLHUP, userdata));
+    EXPECT_TRUE(eof);
+    EXPECT_EQ(0u, io->get_rearms());
+}
+
+TEST_F(DrainIOTest, StopEarlyRearms)
+{
+    fill(100);
+    body = [&](DrainIO::Reader& reader) {
+        char c;
+        EXPECT_EQ(1u, reader.read(&c, 1));
+        EXPECT_FALSE(reader.drained());
+    };
+    expect_attached(expected_event);
+    EXPECT_CALL(mock, sd_event_source_get_enabled(expected_source, testing::_))
+        .WillOnce(DoAll(SetArgPointee<1>(SD_EVENT_ON), Return(0)));
+    EXPECT_CALL(mock,
+                sd_event_source_get_io_events(expected_source, testing::_))
+        .WillOnce(DoAll(SetArgPointee<1>(EPOLLIN | EPOLLET), Return(0)));
+    EXPECT_CALL(mock, sd_event_source_set_io_events(expected_source,
+                                                    EPOLLIN | EPOLLET))
+        .WillOnce(Return(0));
+    EXPECT_EQ(0, handler(nullptr, fds[0], EPOLLIN, userdata));
+    EXPECT_EQ(1u, io->get_rearms());
+}
+
+TEST_F(DrainIOTest, StopEarlyDisabled)
+{
+    fill(100);
+    body = [](DrainIO::Reader& reader) {
+        char c;
+        EXPECT_EQ(1u, reader.read(&c, 1));
+    };
+    expect_attached(expected_event);
+    EXPECT_CALL(mock, sd_event_source_get_enabled(expected_source, testing::_))
+        .WillOnce(DoAll(SetArgPointee<1>(SD_EVENT_OFF), Return(0)));
+    EXPECT_EQ(0, handler(nullptr, fds[0], EPOLLIN, userdata));
+    EXPECT_EQ(0u, io->get_rearms());
+}
+
+TEST_F(DrainIOTest, RearmError)
+{
+    fill(100);
+    body = [](DrainIO::Reader& reader) {
+        char c;
+        EXPECT_EQ(1u, reader.read(&c, 1));
+    };
+    expect_attached(expected_event);
+    EXPECT_CALL(mock, sd_event_source_get_enabled(expected_source, testing::_))
+        .WillOnce(DoAll(SetArgPointee<1>(SD_EVENT_ON), Return(0)));
+    EXPECT_CALL(mock,
+                sd_event_source_get_io_events(expected_source, testing::_))
+        .WillOnce(DoAll(SetArgPointee<1>(EPOLLIN | EPOLLET), Return(0)));
+    EXPECT_CALL(mock, sd_event_source_set_io_events(expected_source,
+                                                    EPOLLIN | EPOLLET))
+        .WillOnce(Return(-ENOMEM));
+    EXPECT_EQ(-ENOMEM, handler(nullptr, fds[0], EPOLLIN, userdata));
+    EXPECT_EQ(0u, io->get_rearms());
+}
+
+TEST_F(DrainIOTest, DrainHelper)
+{
+    fill(10000);
+    size_t chunks = 0, bytes = 0;
+    body = [&](DrainIO::Reader& reader) {
+        char buf[4096];
+        bytes = reader.drain(buf, sizeof(buf), [&](const void*, size_t len) {
+            chunks++;
+            EXPECT_GE(sizeof(buf), len);
+        });
+        EXPECT_TRUE(reader.drained());
+    };
+    EXPECT_EQ(0, handler(nullptr, fds[0], EPOLLIN, userdata));
+    EXPECT_EQ(3u, chunks);
+    EXPECT_EQ(10000u, bytes);
+    EXPECT_EQ(0u, io->get_rearms());
+}
+
+TEST_F(DrainIOTest, CallbackReleases)
+{
+    fill(100);
+    body = [&](DrainIO::Reader& reader) {
+        char c;
+        EXPECT_EQ(1u, reader.read(&c, 1));
+        // sd-event detaches the source but keeps it until the dispatch ends
+        expect_destruct();
+        io.reset();
+    };
+    expect_attached(nullptr);
+    EXPECT_EQ(0, handler(nullptr, fds[0], EPOLLIN, userdata));
+}
+
+TEST_F(DrainIOTest, NoReadRearms)
+{
+    fill(100);
+    // Deferring the peer must not strand the queued data
+    body = [](DrainIO::Reader&) {};
+    expect_attached(expected_event);
+    EXPECT_CALL(mock, sd_event_source_get_enabled(expected_source, testing::_))
+        .WillOnce(DoAll(SetArgPointee<1>(SD_EVENT_ON), Return(0)));
+    EXPECT_CALL(mock,
+                sd_event_source_get_io_events(expected_source, testing::_))
+        .WillOnce(DoAll(SetArgPointee<1>(EPOLLIN | EPOLLET), Return(0)));
+    EXPECT_CALL(mock, sd_event_source_set_io_events(expected_source,
+                                                    EPOLLIN | EPOLLET))
+        .WillOnce(Return(0));
+    EXPECT_EQ(0, handler(nullptr, fds[0], EPOLLIN | EPOLLOUT, userdata));
+    EXPECT_EQ(1u, io->get_rearms());
+}
+
+TEST_F(DrainIOTest, WriteOrErrorNoRearm)
+{
+    size_t calls = 0;
+    body = [&](DrainIO::Reader&) { calls++; };
+    EXPECT_CALL(mock, sd_event_source_set_io_events(testing::_, testing::_))
+        .Times(0);
+    EXPECT_EQ(0, handler(nullptr, fds[0], EPOLLOUT, userdata));
+    EXPECT_EQ(0, handler(nullptr, fds[0], EPOLLERR, userdata));
+    EXPECT_EQ(2u, calls);
+    EXPECT_EQ(0u, io->get_rearms());
+}
+
+TEST_F(DrainIOTest, ReadError)
+{
+    DrainIO::Reader bad(-1);
+    char c;
+    EXPECT_THROW(bad.read(&c, 1), std::system_error);
+    EXPECT_THROW(bad.recv(&c, 1), std::system_error);
+    EXPECT_EQ(-1, bad.get_fd());
+}
+
 } // namespace
 } // namespace source
 } // namespace sdeventplus
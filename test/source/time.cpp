@@ -10,6 +10,8 @@
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <stdexcept>
+#include <system_error>
 #include <utility>
 
 #include <gmock/gmock.h>
@@ -126,6 +128,65 @@ TEST_F(TimeTest, ConstructError)
     EXPECT_TRUE(callback);
 }
 
+TEST_F(TimeTest, StaticConstructSuccess)
+{
+    constexpr ClockId id = ClockId::RealTime;
+    const Time<id>::TimePoint expected_time(std::chrono::seconds{2});
+    const Time<id>::Accuracy expected_accuracy(std::chrono::milliseconds{50});
+    Time<id>::TimePoint saved_time, other_time;
+    // Capturing lambdas have a deleted copy assignment
+    auto make_callback = [](Time<id>::TimePoint* out) {
+        return [out](Time<id>&, Time<id>::TimePoint time) { *out = time; };
+    };
+    auto callback = make_callback(&saved_time);
+
+    EXPECT_CALL(mock, sd_event_ref(expected_event))
+        .WillOnce(Return(expected_event));
+    sd_event_time_handler_t handler;
+    EXPECT_CALL(mock,
+                sd_event_add_time(expected_event, testing::_, CLOCK_REALTIME,
+                                  2000000, 50000, testing::_, nullptr))
+        .WillOnce(DoAll(SetArgPointee<1>(expected_source), SaveArg<5>(&handler),
+                        Return(0)));
+    sd_event_destroy_t destroy;
+    void* userdata;
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(mock, sd_event_source_set_destroy_callback(expected_source,
+                                                               testing::_))
+            .WillOnce(DoAll(SaveArg<1>(&destroy), Return(0)));
+        EXPECT_CALL(mock,
+                    sd_event_source_set_userdata(expected_source, testing::_))
+            .WillOnce(DoAll(SaveArg<1>(&userdata), Return(nullptr)));
+        EXPECT_CALL(mock, sd_event_source_get_userdata(expected_source))
+            .WillRepeatedly(ReturnPointee(&userdata));
+    }
+    StaticTime<id, decltype(callback)> time(
+        *event, expected_time, expected_accuracy, std::move(callback));
+    EXPECT_NE(&time, userdata);
+    EXPECT_EQ(expected_event, time.get_event().get());
+    EXPECT_EQ(expected_source, time.get());
+
+    EXPECT_EQ(0, handler(nullptr, 2000100, userdata));
+    EXPECT_EQ(Time<id>::TimePoint(std::chrono::microseconds(2000100)),
+              saved_time);
+
+    time.set_callback(make_callback(&other_time));
+    EXPECT_EQ(0, handler(nullptr, 2000200, userdata));
+    EXPECT_EQ(Time<id>::TimePoint(std::chrono::microseconds(2000100)),
+              saved_time);
+    EXPECT_EQ(Time<id>::TimePoint(std::chrono::microseconds(2000200)),
+              other_time);
+
+    // The type erased callback setter can not store into the static userdata
+    Time<id>& base = time;
+    EXPECT_THROW(base.set_callback([](Time<id>&, Time<id>::TimePoint) {}),
+                 std::runtime_error);
+
+    expect_time_destroy(expected_event, expected_source);
+    destroy(userdata);
+}
+
 class TimeMethodTest : public TimeTest
 {
   protected:
@@ -215,6 +276,23 @@ TEST_F(TimeMethodTest, SetTimeError)
                  SdEventError);
 }
 
+TEST_F(TimeMethodTest, SetTimeRelativeSuccess)
+{
+    EXPECT_CALL(mock,
+                sd_event_source_set_time_relative(expected_source, 2000000))
+        .WillOnce(Return(0));
+    time->set_time_relative(std::chrono::seconds{2});
+}
+
+TEST_F(TimeMethodTest, SetTimeRelativeError)
+{
+    EXPECT_CALL(mock,
+                sd_event_source_set_time_relative(expected_source, 2000000))
+        .WillOnce(Return(-EINVAL));
+    EXPECT_THROW(time->set_time_relative(std::chrono::seconds{2}),
+                 SdEventError);
+}
+
 TEST_F(TimeMethodTest, GetTimeSuccess)
 {
     EXPECT_CALL(mock, sd_event_source_get_time(expected_source, testing::_))
@@ -246,6 +324,17 @@ TEST_F(TimeMethodTest, SetAccuracyError)
     EXPECT_THROW(time->set_accuracy(std::chrono::seconds{5}), SdEventError);
 }
 
+TEST_F(TimeMethodTest, TryMovedFrom)
+{
+    Time<id> moved(std::move(*time));
+    const auto errc = std::errc::bad_file_descriptor;
+    EXPECT_EQ(errc, time->try_set_time(Time<id>::TimePoint()).error());
+    EXPECT_EQ(errc,
+              time->try_set_time_relative(std::chrono::seconds{1}).error());
+    EXPECT_EQ(errc, time->try_set_accuracy(std::chrono::seconds{1}).error());
+    *time = std::move(moved);
+}
+
 TEST_F(TimeMethodTest, GetAccuracySuccess)
 {
     EXPECT_CALL(mock,
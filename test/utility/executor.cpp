@@ -0,0 +1,126 @@
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/executor.hpp>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace sdeventplus
+{
+namespace utility
+{
+namespace
+{
+
+class ExecutorTest : public testing::Test
+{
+  protected:
+    Event event = Event::get_new();
+    Executor executor{event};
+
+    /** @brief Runs the loop until the predicate holds or no event arrives
+     *         for a while
+     */
+    template <typename Pred>
+    void runUntil(Pred&& pred)
+    {
+        while (!pred())
+        {
+            ASSERT_LT(0, event.run(std::chrono::seconds{5}));
+        }
+    }
+};
+
+TEST_F(ExecutorTest, RunsInOrder)
+{
+    std::vector<int> ran;
+    for (int i = 0; i < 5; ++i)
+    {
+        executor.post([&ran, i]() { ran.push_back(i); });
+    }
+    EXPECT_TRUE(ran.empty());
+
+    // A single wakeup runs the whole batch
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ((std::vector<int>{0, 1, 2, 3, 4}), ran);
+    EXPECT_EQ(0, event.run(std::chrono::seconds{0}));
+}
+
+TEST_F(ExecutorTest, PostFromTask)
+{
+    int ran = 0;
+    executor.post([&]() {
+        ran++;
+        executor.post([&]() { ran++; });
+    });
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ(1, ran);
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ(2, ran);
+}
+
+TEST_F(ExecutorTest, TaskThrows)
+{
+    int ran = 0;
+    executor.post([]() { throw std::runtime_error("task"); });
+    executor.post([&]() { ran++; });
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ(1, ran);
+}
+
+TEST_F(ExecutorTest, DropsQueued)
+{
+    auto owned = std::make_shared<int>(0);
+    executor.post([owned]() {});
+    EXPECT_EQ(2, owned.use_count());
+    executor = Executor(event);
+    EXPECT_EQ(1, owned.use_count());
+}
+
+TEST_F(ExecutorTest, PostMovedFrom)
+{
+    Executor moved(std::move(executor));
+    EXPECT_THROW(executor.post([]() {}), std::runtime_error);
+    int ran = 0;
+    moved.post([&]() { ran++; });
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ(1, ran);
+}
+
+TEST_F(ExecutorTest, MultipleProducers)
+{
+    constexpr size_t producers = 4;
+    constexpr size_t perProducer = 10000;
+    std::vector<size_t> last(producers);
+    size_t ran = 0;
+    bool ordered = true;
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&, p]() {
+            for (size_t i = 1; i <= perProducer; ++i)
+            {
+                executor.post([&, p, i]() {
+                    ordered = ordered && last[p] + 1 == i;
+                    last[p] = i;
+                    ran++;
+                });
+            }
+        });
+    }
+    runUntil([&]() { return ran == producers * perProducer; });
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_TRUE(ordered);
+}
+
+} // namespace
+} // namespace utility
+} // namespace sdeventplus
@@ -0,0 +1,148 @@
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/base.hpp>
+#include <sdeventplus/source/event.hpp>
+#include <sdeventplus/utility/flush_scheduler.hpp>
+
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace sdeventplus
+{
+namespace utility
+{
+namespace
+{
+
+class FlushSchedulerTest : public testing::Test
+{
+  protected:
+    Event event = Event::get_new();
+    FlushScheduler scheduler{event};
+    std::vector<int> flushed;
+
+    /** @brief Creates a oneshot source requesting the flushes when run */
+    source::Defer requester(std::vector<FlushScheduler::Id> ids)
+    {
+        return source::Defer(event, [this, ids](source::EventBase& source) {
+            for (auto id : ids)
+            {
+                scheduler.request(id);
+            }
+            source.set_enabled(source::Enabled::Off);
+        });
+    }
+};
+
+TEST_F(FlushSchedulerTest, Idle)
+{
+    scheduler.add([&]() { flushed.push_back(0); });
+    EXPECT_EQ(0, event.run(std::chrono::seconds{0}));
+    EXPECT_TRUE(flushed.empty());
+}
+
+TEST_F(FlushSchedulerTest, IdleAfterDispatch)
+{
+    scheduler.add([&]() { flushed.push_back(0); });
+    // Other sources are not followed by a dispatch of the idle scheduler
+    auto r = requester({});
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ(0, event.run(std::chrono::seconds{0}));
+    EXPECT_TRUE(flushed.empty());
+}
+
+TEST_F(FlushSchedulerTest, CoalescesWithinIteration)
+{
+    auto a = scheduler.add([&]() { flushed.push_back(0); });
+    auto b = scheduler.add([&]() { flushed.push_back(1); });
+    auto r1 = requester({b, a, b});
+    auto r2 = requester({a});
+
+    // Both requesters are dispatched before the lower priority flush
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_TRUE(flushed.empty());
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ((std::vector<int>{1, 0}), flushed);
+    EXPECT_EQ(0, event.run(std::chrono::seconds{0}));
+
+    EXPECT_EQ(4, scheduler.get_requests());
+    EXPECT_EQ(2, scheduler.get_flushes());
+    EXPECT_EQ(2, scheduler.get_coalesced());
+}
+
+TEST_F(FlushSchedulerTest, RequestFromFlush)
+{
+    FlushScheduler::Id id = scheduler.add([&]() {
+        flushed.push_back(0);
+        if (flushed.size() == 1)
+        {
+            scheduler.request(id);
+        }
+    });
+    auto r1 = requester({id});
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ(1, flushed.size());
+
+    // The request made by the flush runs in the next iteration
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ(2, flushed.size());
+    EXPECT_EQ(0, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ(0, scheduler.get_coalesced());
+}
+
+TEST_F(FlushSchedulerTest, CallbackThrows)
+{
+    auto a = scheduler.add([]() { throw std::runtime_error("flush"); });
+    auto b = scheduler.add([&]() { flushed.push_back(1); });
+    auto r = requester({a, b});
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ((std::vector<int>{1}), flushed);
+    EXPECT_EQ(2, scheduler.get_flushes());
+}
+
+TEST_F(FlushSchedulerTest, CallbackDestroysScheduler)
+{
+    std::optional<FlushScheduler> owned(std::in_place, event);
+    auto a = owned->add([&]() {
+        flushed.push_back(0);
+        owned.reset();
+    });
+    auto b = owned->add([&]() { flushed.push_back(1); });
+    source::Defer r(event, [&](source::EventBase& source) {
+        owned->request(a);
+        owned->request(b);
+        source.set_enabled(source::Enabled::Off);
+    });
+    // The fixture scheduler is pending alongside and may be dispatched first
+    while (event.run(std::chrono::seconds{0}) > 0)
+    {}
+    EXPECT_EQ((std::vector<int>{0}), flushed);
+    EXPECT_FALSE(owned);
+}
+
+TEST_F(FlushSchedulerTest, MoveAssign)
+{
+    auto old = scheduler.add([&]() { flushed.push_back(0); });
+    scheduler.request(old);
+    scheduler = FlushScheduler(event);
+    auto id = scheduler.add([&]() { flushed.push_back(1); });
+    auto r = requester({id});
+    while (event.run(std::chrono::seconds{0}) > 0)
+    {}
+    EXPECT_EQ((std::vector<int>{1}), flushed);
+}
+
+TEST_F(FlushSchedulerTest, InvalidId)
+{
+    EXPECT_THROW(scheduler.request(0), std::out_of_range);
+}
+
+} // namespace
+} // namespace utility
+} // namespace sdeventplus
@@ -0,0 +1,176 @@
+#include <systemd/sd-event.h>
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/exception.hpp>
+#include <sdeventplus/test/sdevent.hpp>
+#include <sdeventplus/utility/memory_trimmer.hpp>
+
+#include <cerrno>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace sdeventplus
+{
+namespace utility
+{
+namespace
+{
+
+using testing::DoAll;
+using testing::ElementsAre;
+using testing::Return;
+using testing::ReturnPointee;
+using testing::SaveArg;
+using testing::SetArgPointee;
+
+class MemoryTrimmerTest : public testing::Test
+{
+  protected:
+    testing::StrictMock<test::SdEventMock> mock;
+    sd_event* const expected_event = reinterpret_cast<sd_event*>(1234);
+    sd_event_source* const expected_source =
+        reinterpret_cast<sd_event_source*>(2345);
+    std::unique_ptr<Event> event;
+
+    sd_event_handler_t handler = nullptr;
+    sd_event_destroy_t destroy = nullptr;
+    void* userdata = nullptr;
+
+    void SetUp()
+    {
+        event = std::make_unique<Event>(expected_event, std::false_type(),
+                                        &mock);
+    }
+
+    void TearDown()
+    {
+        EXPECT_CALL(mock, sd_event_unref(expected_event))
+            .WillOnce(Return(nullptr));
+        event.reset();
+    }
+
+    void expectUnsupported(int r)
+    {
+        EXPECT_CALL(mock, sd_event_add_memory_pressure(
+                              expected_event, testing::_, testing::_, nullptr))
+            .WillOnce(Return(r));
+    }
+
+    void expectSource()
+    {
+        EXPECT_CALL(mock, sd_event_ref(expected_event))
+            .WillOnce(Return(expected_event));
+        EXPECT_CALL(mock, sd_event_add_memory_pressure(
+                              expected_event, testing::_, testing::_, nullptr))
+            .WillOnce(DoAll(SetArgPointee<1>(expected_source),
+                            SaveArg<2>(&handler), Return(0)));
+        EXPECT_CALL(mock, sd_event_source_set_destroy_callback(expected_source,
+                                                               testing::_))
+            .WillOnce(DoAll(SaveArg<1>(&destroy), Return(0)));
+        EXPECT_CALL(mock,
+                    sd_event_source_set_userdata(expected_source, testing::_))
+            .WillOnce(DoAll(SaveArg<1>(&userdata), Return(nullptr)));
+        EXPECT_CALL(mock, sd_event_source_get_userdata(expected_source))
+            .WillRepeatedly(ReturnPointee(&userdata));
+    }
+
+    void expectDestroy()
+    {
+        EXPECT_CALL(mock, sd_event_source_unref(expected_source))
+            .WillOnce(Return(nullptr));
+        EXPECT_CALL(mock, sd_event_unref(expected_event))
+            .WillOnce(Return(nullptr));
+    }
+};
+
+TEST_F(MemoryTrimmerTest, Unsupported)
+{
+    expectUnsupported(-EOPNOTSUPP);
+    MemoryTrimmer trimmer(*event);
+    EXPECT_FALSE(trimmer.supported());
+    EXPECT_EQ(nullptr, trimmer.get_source());
+
+    std::vector<int> order;
+    trimmer.add([&] { order.push_back(10); }, 10);
+    trimmer.add([&] { order.push_back(-5); }, -5);
+    trimmer.add([&] { order.push_back(0); });
+    trimmer.add([&] { order.push_back(1); }, 0);
+    trimmer.trim();
+    EXPECT_THAT(order, ElementsAre(-5, 0, 1, 10));
+    EXPECT_EQ(1u, trimmer.get_trims());
+}
+
+TEST_F(MemoryTrimmerTest, CallbackDestroysTrimmer)
+{
+    expectUnsupported(-EOPNOTSUPP);
+    auto trimmer = std::make_unique<MemoryTrimmer>(*event);
+    std::vector<int> order;
+    trimmer->add([&] {
+        order.push_back(0);
+        trimmer.reset();
+    });
+    trimmer->add([&] { order.push_back(1); }, 1);
+    trimmer->trim();
+    EXPECT_THAT(order, ElementsAre(0));
+}
+
+TEST_F(MemoryTrimmerTest, Disabled)
+{
+    expectUnsupported(-EHOSTDOWN);
+    MemoryTrimmer trimmer(*event);
+    EXPECT_FALSE(trimmer.supported());
+}
+
+TEST_F(MemoryTrimmerTest, ConstructError)
+{
+    expectUnsupported(-EINVAL);
+    EXPECT_THROW(MemoryTrimmer trimmer(*event), SdEventError);
+}
+
+TEST_F(MemoryTrimmerTest, TrimsOnPressure)
+{
+    expectSource();
+    auto trimmer = std::make_unique<MemoryTrimmer>(*event);
+    EXPECT_TRUE(trimmer->supported());
+    EXPECT_NE(nullptr, trimmer->get_source());
+
+    std::vector<int> order;
+    MemoryTrimmer::Id self = trimmer->add(
+        [&] {
+            order.push_back(0);
+            EXPECT_TRUE(trimmer->remove(self));
+        },
+        0);
+    trimmer->add([&] { throw std::runtime_error("cache"); }, 1);
+    MemoryTrimmer::Id last = trimmer->add([&] { order.push_back(2); }, 2);
+    trimmer->add(
+        [&] {
+            order.push_back(-1);
+            // Nested trims are ignored
+            trimmer->trim();
+        },
+        -1);
+
+    EXPECT_EQ(0, handler(expected_source, userdata));
+    EXPECT_THAT(order, ElementsAre(-1, 0, 2));
+    EXPECT_EQ(1u, trimmer->get_trims());
+
+    order.clear();
+    EXPECT_FALSE(trimmer->remove(self));
+    EXPECT_TRUE(trimmer->remove(last));
+    EXPECT_EQ(0, handler(expected_source, userdata));
+    EXPECT_THAT(order, ElementsAre(-1));
+    EXPECT_EQ(2u, trimmer->get_trims());
+
+    expectDestroy();
+    trimmer.reset();
+    destroy(userdata);
+}
+
+} // namespace
+} // namespace utility
+} // namespace sdeventplus
@@ -0,0 +1,154 @@
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/source_pool.hpp>
+
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+namespace sdeventplus
+{
+namespace utility
+{
+namespace
+{
+
+constexpr auto timeout = std::chrono::seconds{1};
+
+class TimePoolTest : public testing::Test
+{
+  protected:
+    static constexpr ClockId id = ClockId::Monotonic;
+    Event event = Event::get_new();
+    TimePool<id> pool{event, 1};
+    int ran = 0;
+
+    PoolTicket scheduleNow()
+    {
+        return pool.schedule_after(std::chrono::microseconds{0},
+                                   std::chrono::microseconds{1},
+                                   [this]() { ran++; });
+    }
+};
+
+TEST_F(TimePoolTest, ReusesSource)
+{
+    auto first = scheduleNow();
+    EXPECT_EQ(1, pool.active());
+    EXPECT_EQ(0, pool.parked());
+    EXPECT_EQ(1, event.run(timeout));
+    EXPECT_EQ(1, ran);
+    EXPECT_EQ(0, pool.active());
+    EXPECT_EQ(1, pool.parked());
+
+    auto second = pool.schedule(Clock<id>(event).now(),
+                                std::chrono::microseconds{1},
+                                [this]() { ran++; });
+    EXPECT_EQ(first.slot, second.slot);
+    EXPECT_NE(first.generation, second.generation);
+    EXPECT_EQ(0, pool.parked());
+    EXPECT_EQ(1, event.run(timeout));
+    EXPECT_EQ(2, ran);
+    EXPECT_EQ(0, event.run(std::chrono::seconds{0}));
+}
+
+TEST_F(TimePoolTest, Cancel)
+{
+    auto ticket = pool.schedule_after(std::chrono::hours{1},
+                                      std::chrono::microseconds{1},
+                                      [this]() { ran++; });
+    EXPECT_TRUE(pool.cancel(ticket));
+    EXPECT_FALSE(pool.cancel(ticket));
+    EXPECT_EQ(0, pool.active());
+    EXPECT_EQ(1, pool.parked());
+
+    // A stale ticket does not cancel the next use of the source
+    scheduleNow();
+    EXPECT_FALSE(pool.cancel(ticket));
+    EXPECT_EQ(1, event.run(timeout));
+    EXPECT_EQ(1, ran);
+}
+
+TEST_F(TimePoolTest, Capacity)
+{
+    scheduleNow();
+    scheduleNow();
+    EXPECT_EQ(2, pool.active());
+    while (ran < 2)
+    {
+        ASSERT_LT(0, event.run(timeout));
+    }
+    EXPECT_EQ(1, pool.parked());
+    pool.set_capacity(0);
+    EXPECT_EQ(0, pool.get_capacity());
+    EXPECT_EQ(0, pool.parked());
+}
+
+TEST_F(TimePoolTest, ScheduleFromCallback)
+{
+    pool.schedule_after(std::chrono::microseconds{0},
+                        std::chrono::microseconds{1}, [this]() {
+                            ran++;
+                            scheduleNow();
+                        });
+    EXPECT_EQ(1, event.run(timeout));
+    EXPECT_EQ(1, pool.active());
+    EXPECT_EQ(1, event.run(timeout));
+    EXPECT_EQ(2, ran);
+}
+
+TEST_F(TimePoolTest, CallbackThrows)
+{
+    pool.schedule_after(std::chrono::microseconds{0},
+                        std::chrono::microseconds{1},
+                        []() { throw std::runtime_error("timeout"); });
+    EXPECT_EQ(1, event.run(timeout));
+    EXPECT_EQ(0, pool.active());
+    EXPECT_EQ(1, pool.parked());
+}
+
+TEST_F(TimePoolTest, MovedFrom)
+{
+    TimePool<id> moved(std::move(pool));
+    EXPECT_THROW(scheduleNow(), std::runtime_error);
+    EXPECT_THROW(pool.cancel({0, 0}), std::runtime_error);
+    EXPECT_THROW(pool.active(), std::runtime_error);
+    EXPECT_EQ(0, moved.active());
+}
+
+TEST(DeferPoolTest, MovedFrom)
+{
+    Event event = Event::get_new();
+    DeferPool pool(event, 1);
+    DeferPool moved(std::move(pool));
+    EXPECT_THROW(pool.schedule([]() {}), std::runtime_error);
+    EXPECT_THROW(pool.set_capacity(2), std::runtime_error);
+    int ran = 0;
+    moved.schedule([&]() { ran++; });
+    EXPECT_EQ(1, event.run(timeout));
+    EXPECT_EQ(1, ran);
+}
+
+TEST(DeferPoolTest, RunsOnce)
+{
+    Event event = Event::get_new();
+    DeferPool pool(event);
+    int ran = 0;
+    pool.schedule([&]() { ran++; });
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ(1, ran);
+    EXPECT_EQ(0, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ(1, pool.parked());
+
+    auto ticket = pool.schedule([&]() { ran++; });
+    EXPECT_EQ(0, pool.parked());
+    EXPECT_TRUE(pool.cancel(ticket));
+    EXPECT_EQ(0, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ(1, ran);
+}
+
+} // namespace
+} // namespace utility
+} // namespace sdeventplus
@@ -0,0 +1,135 @@
+#include <signal.h>
+#include <sys/wait.h>
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/spawner.hpp>
+#include <stdplus/signal.hpp>
+
+#include <cerrno>
+#include <chrono>
+#include <optional>
+#include <system_error>
+
+#include <gtest/gtest.h>
+
+namespace sdeventplus
+{
+namespace utility
+{
+namespace
+{
+
+class SpawnerTest : public testing::Test
+{
+  protected:
+    Event event = Event::get_new();
+    std::optional<Spawner> spawner;
+
+    SpawnerTest()
+    {
+        stdplus::signal::block(SIGCHLD);
+        spawner.emplace(event);
+    }
+
+    void runUntil(const bool& done)
+    {
+        while (!done)
+        {
+            ASSERT_LT(0, event.run(std::chrono::seconds{5}));
+        }
+    }
+};
+
+TEST_F(SpawnerTest, ExitStatus)
+{
+    const char* argv[] = {"sh", "-c", "exit 3", nullptr};
+    bool done = false;
+    pid_t exited = 0;
+    int code = 0, status = 0;
+    const pid_t pid = spawner->spawn(argv, [&](pid_t pid, const siginfo_t* si) {
+        exited = pid;
+        code = si->si_code;
+        status = si->si_status;
+        done = true;
+    });
+    EXPECT_EQ(1u, spawner->get_running());
+    EXPECT_EQ(1u, spawner->get_spawned());
+
+    runUntil(done);
+    EXPECT_EQ(pid, exited);
+    EXPECT_EQ(CLD_EXITED, code);
+    EXPECT_EQ(3, status);
+    EXPECT_EQ(0u, spawner->get_running());
+
+    // The child was reaped along with its source
+    EXPECT_EQ(-1, waitpid(pid, nullptr, WNOHANG));
+    EXPECT_EQ(ECHILD, errno);
+}
+
+TEST_F(SpawnerTest, Kill)
+{
+    const char* argv[] = {"sleep", "10", nullptr};
+    bool done = false;
+    int code = 0, status = 0;
+    const pid_t pid =
+        spawner->spawn(argv, [&](pid_t, const siginfo_t* si) {
+            code = si->si_code;
+            status = si->si_status;
+            done = true;
+        });
+    EXPECT_TRUE(spawner->kill(pid));
+
+    runUntil(done);
+    EXPECT_EQ(CLD_KILLED, code);
+    EXPECT_EQ(SIGTERM, status);
+    EXPECT_FALSE(spawner->kill(pid));
+}
+
+TEST_F(SpawnerTest, SpawnError)
+{
+    const char* argv[] = {"/nonexistent/sdeventplus", nullptr};
+    bool called = false;
+    EXPECT_THROW(
+        spawner->spawn(argv, [&](pid_t, const siginfo_t*) { called = true; }),
+        std::system_error);
+    EXPECT_EQ(0u, spawner->get_running());
+    EXPECT_EQ(0u, spawner->get_spawned());
+    EXPECT_FALSE(called);
+}
+
+TEST_F(SpawnerTest, DestroyKills)
+{
+    const char* argv[] = {"sleep", "10", nullptr};
+    bool called = false;
+    const pid_t pid = spawner->spawn(
+        argv, [&](pid_t, const siginfo_t*) { called = true; });
+    spawner.reset();
+
+    EXPECT_FALSE(called);
+    EXPECT_EQ(-1, waitpid(pid, nullptr, WNOHANG));
+    EXPECT_EQ(ECHILD, errno);
+}
+
+TEST_F(SpawnerTest, Many)
+{
+    const char* argv[] = {"true", nullptr};
+    constexpr size_t count = 32;
+    size_t exited = 0;
+    bool done = false;
+    for (size_t i = 0; i < count; ++i)
+    {
+        spawner->spawn(argv, [&](pid_t, const siginfo_t* si) {
+            EXPECT_EQ(CLD_EXITED, si->si_code);
+            done = ++exited == count;
+        });
+    }
+    EXPECT_EQ(count, spawner->get_running());
+
+    runUntil(done);
+    EXPECT_EQ(0u, spawner->get_running());
+    EXPECT_EQ(count, spawner->get_spawned());
+}
+
+} // namespace
+} // namespace utility
+} // namespace sdeventplus
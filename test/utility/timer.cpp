@@ -78,6 +78,13 @@ class TimerTest : public testing::Test
             .WillOnce(Return(0));
     }
 
+    void expectSetTimeRelative(microseconds time)
+    {
+        EXPECT_CALL(mock, sd_event_source_set_time_relative(expected_source,
+                                                            time.count()))
+            .WillOnce(Return(0));
+    }
+
     void expectSetEnabled(source::Enabled enabled)
     {
         EXPECT_CALL(mock, sd_event_source_set_enabled(
@@ -104,9 +111,7 @@ class TimerTest : public testing::Test
 
     void expireTimer()
     {
-        const milliseconds new_time(90);
-        expectNow(new_time);
-        expectSetTime(new_time + interval);
+        expectSetTimeRelative(interval);
         EXPECT_EQ(0, handler(nullptr, 0, handler_userdata));
         EXPECT_TRUE(timer->hasExpired());
         EXPECT_EQ(interval, timer->getInterval());
@@ -174,8 +179,7 @@ TEST_F(TimerTest, NoCallback)
     expectSetEnabled(source::Enabled::On);
     timer = std::make_unique<TestTimer>(*event, nullptr, interval);
 
-    expectNow(starting_time);
-    expectSetTime(starting_time + interval);
+    expectSetTimeRelative(interval);
     EXPECT_EQ(0, handler(nullptr, 0, handler_userdata));
 }
 
@@ -320,9 +324,7 @@ TEST_F(TimerTest, SetIntervalEmpty)
 
 TEST_F(TimerTest, CallbackHappensLast)
 {
-    const milliseconds new_time(90);
-    expectNow(new_time);
-    expectSetTime(new_time + interval);
+    expectSetTimeRelative(interval);
     callback = [&]() {
         EXPECT_TRUE(timer->hasExpired());
         expectSetEnabled(source::Enabled::On);
@@ -391,25 +393,20 @@ TEST_F(TimerTest, CallbackMove)
     timer = std::make_unique<TestTimer>(std::move(local_timer));
 
     // handler_userdata should have been updated and the callback should work
-    const milliseconds new_time(90);
-    expectNow(new_time);
-    expectSetTime(new_time + interval);
+    expectSetTimeRelative(interval);
     EXPECT_EQ(0, handler(nullptr, 0, handler_userdata));
     EXPECT_EQ(1, called);
 
     // update the callback and make sure it still works
     timer->set_callback(std::bind([]() {}));
-    expectNow(new_time);
-    expectSetTime(new_time + interval);
+    expectSetTimeRelative(interval);
     EXPECT_EQ(0, handler(nullptr, 0, handler_userdata));
     EXPECT_EQ(1, called);
 }
 
 TEST_F(TimerTest, SetValuesExpiredTimer)
 {
-    const milliseconds new_time(90);
-    expectNow(new_time);
-    expectSetTime(new_time + interval);
+    expectSetTimeRelative(interval);
     EXPECT_EQ(0, handler(nullptr, 0, handler_userdata));
     EXPECT_TRUE(timer->hasExpired());
     EXPECT_EQ(interval, timer->getInterval());
@@ -440,7 +437,6 @@ TEST_F(TimerTest, Restart)
     const milliseconds new_interval(471);
     expectNow(starting_time);
     expectSetTime(starting_time + new_interval);
-    expectSetEnabled(source::Enabled::On);
     timer->restart(new_interval);
     EXPECT_FALSE(timer->hasExpired());
     EXPECT_EQ(new_interval, timer->getInterval());
@@ -466,7 +462,6 @@ TEST_F(TimerTest, RestartOnce)
     const milliseconds remaining(471);
     expectNow(starting_time);
     expectSetTime(starting_time + remaining);
-    expectSetEnabled(source::Enabled::On);
     timer->restartOnce(remaining);
     EXPECT_FALSE(timer->hasExpired());
     EXPECT_EQ(std::nullopt, timer->getInterval());
@@ -474,6 +469,81 @@ TEST_F(TimerTest, RestartOnce)
     timer->setEnabled(true);
 }
 
+TEST_F(TimerTest, RestartOnceRedundant)
+{
+    const milliseconds remaining(471);
+    expectNow(starting_time);
+    expectSetTime(starting_time + remaining);
+    timer->restartOnce(remaining);
+
+    // Kicked again within the same iteration
+    expectNow(starting_time);
+    timer->restartOnce(remaining);
+
+    // The next iteration only moves the expiration
+    expectNow(starting_time2);
+    expectSetTime(starting_time2 + remaining);
+    timer->restartOnce(remaining);
+}
+
+TEST_F(TimerTest, FixedRate)
+{
+    EXPECT_EQ(std::nullopt, timer->getFixedRate());
+    timer->setFixedRate(CatchUp::Skip);
+    EXPECT_EQ(CatchUp::Skip, timer->getFixedRate());
+
+    // Dispatch latency does not shift the schedule
+    const microseconds deadline = starting_time + interval;
+    expectNow(deadline + milliseconds(7));
+    expectSetTime(deadline + interval);
+    EXPECT_EQ(0, handler(nullptr, deadline.count(), handler_userdata));
+    EXPECT_TRUE(timer->hasExpired());
+    EXPECT_EQ(0, timer->getMissed());
+
+    timer->setFixedRate(std::nullopt);
+    expectSetTimeRelative(interval);
+    EXPECT_EQ(0, handler(nullptr, deadline.count(), handler_userdata));
+}
+
+TEST_F(TimerTest, FixedRateSkip)
+{
+    timer->setFixedRate(CatchUp::Skip);
+    const microseconds deadline = starting_time + interval;
+    expectNow(deadline + 2 * interval + milliseconds(1));
+    expectSetTime(deadline + 3 * interval);
+    EXPECT_EQ(0, handler(nullptr, deadline.count(), handler_userdata));
+    EXPECT_EQ(0, timer->getMissed());
+}
+
+TEST_F(TimerTest, FixedRateReport)
+{
+    timer->setFixedRate(CatchUp::Report);
+    uint64_t missed = 0;
+    callback = [&]() { missed = timer->getMissed(); };
+    const microseconds deadline = starting_time + interval;
+    expectNow(deadline + 2 * interval + milliseconds(1));
+    expectSetTime(deadline + 3 * interval);
+    EXPECT_EQ(0, handler(nullptr, deadline.count(), handler_userdata));
+    EXPECT_EQ(2, missed);
+
+    // An expiration exactly due is not missed
+    expectNow(deadline + 4 * interval);
+    expectSetTime(deadline + 4 * interval);
+    EXPECT_EQ(0, handler(nullptr, (deadline + 3 * interval).count(),
+                         handler_userdata));
+    EXPECT_EQ(0, missed);
+}
+
+TEST_F(TimerTest, FixedRateBurst)
+{
+    timer->setFixedRate(CatchUp::Burst);
+    const microseconds deadline = starting_time + interval;
+    expectNow(deadline + 2 * interval + milliseconds(1));
+    expectSetTime(deadline + interval);
+    EXPECT_EQ(0, handler(nullptr, deadline.count(), handler_userdata));
+    EXPECT_EQ(0, timer->getMissed());
+}
+
 } // namespace
 } // namespace utility
 } // namespace sdeventplus
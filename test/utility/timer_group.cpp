@@ -0,0 +1,240 @@
+#include <systemd/sd-event.h>
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/test/sdevent.hpp>
+#include <sdeventplus/utility/timer_group.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace sdeventplus
+{
+namespace utility
+{
+namespace
+{
+
+constexpr ClockId testClock = ClockId::Monotonic;
+
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+using testing::DoAll;
+using testing::Return;
+using testing::ReturnPointee;
+using testing::SaveArg;
+using testing::SetArgPointee;
+using TestGroup = TimerGroup<testClock>;
+
+class TimerGroupTest : public testing::Test
+{
+  protected:
+    testing::StrictMock<test::SdEventMock> mock;
+    sd_event* const expected_event = reinterpret_cast<sd_event*>(1234);
+    sd_event_source* const expected_source =
+        reinterpret_cast<sd_event_source*>(2345);
+    sd_event_time_handler_t handler = nullptr;
+    void* handler_userdata;
+    sd_event_destroy_t handler_destroy;
+    microseconds now{milliseconds{10}};
+    uint64_t armed_time = 0;
+    int enabled = SD_EVENT_ON;
+    std::unique_ptr<Event> event;
+    std::unique_ptr<TestGroup> group;
+
+    void SetUp()
+    {
+        EXPECT_CALL(mock, sd_event_ref(expected_event))
+            .WillRepeatedly(Return(expected_event));
+        EXPECT_CALL(mock, sd_event_unref(expected_event))
+            .WillRepeatedly(Return(nullptr));
+        event = std::make_unique<Event>(expected_event, &mock);
+        EXPECT_CALL(mock, sd_event_source_unref(expected_source))
+            .WillRepeatedly(Return(nullptr));
+        EXPECT_CALL(mock, sd_event_source_set_destroy_callback(expected_source,
+                                                               testing::_))
+            .WillRepeatedly(DoAll(SaveArg<1>(&handler_destroy), Return(0)));
+        EXPECT_CALL(mock,
+                    sd_event_source_set_userdata(expected_source, testing::_))
+            .WillRepeatedly(
+                DoAll(SaveArg<1>(&handler_userdata), Return(nullptr)));
+        EXPECT_CALL(mock, sd_event_source_get_userdata(expected_source))
+            .WillRepeatedly(ReturnPointee(&handler_userdata));
+        EXPECT_CALL(mock, sd_event_now(expected_event,
+                                       static_cast<clockid_t>(testClock),
+                                       testing::_))
+            .WillRepeatedly([&](sd_event*, clockid_t, uint64_t* usec) {
+                *usec = now.count();
+                return 0;
+            });
+        EXPECT_CALL(mock, sd_event_source_set_time(expected_source, testing::_))
+            .WillRepeatedly(DoAll(SaveArg<1>(&armed_time), Return(0)));
+        EXPECT_CALL(mock,
+                    sd_event_source_set_enabled(expected_source, testing::_))
+            .WillRepeatedly(DoAll(SaveArg<1>(&enabled), Return(0)));
+
+        EXPECT_CALL(mock, sd_event_add_time(expected_event, testing::_,
+                                            static_cast<clockid_t>(testClock),
+                                            0, 1, testing::_, nullptr))
+            .WillOnce(DoAll(SetArgPointee<1>(expected_source),
+                            SaveArg<5>(&handler), Return(0)));
+        group = std::make_unique<TestGroup>(*event, milliseconds{10});
+        EXPECT_EQ(SD_EVENT_OFF, enabled);
+        EXPECT_EQ(expected_event, group->get_event().get());
+        EXPECT_EQ(milliseconds{10}, group->get_slack());
+    }
+
+    void TearDown()
+    {
+        group.reset();
+        handler_destroy(handler_userdata);
+    }
+
+    /** @brief Dispatches the time source like sd-event would, until the
+     *         given time is reached
+     */
+    void runUntil(microseconds time)
+    {
+        while (enabled == SD_EVENT_ONESHOT && microseconds{armed_time} <= time)
+        {
+            now = std::max(now, microseconds{armed_time});
+            enabled = SD_EVENT_OFF;
+            EXPECT_EQ(0, handler(nullptr, armed_time, handler_userdata));
+        }
+        now = time;
+    }
+};
+
+TEST_F(TimerGroupTest, Coalesce)
+{
+    std::vector<std::pair<int, microseconds>> fired;
+    auto record = [&](int id) {
+        return [&, id]() { fired.emplace_back(id, now); };
+    };
+    group->add(milliseconds{100}, record(0));
+    EXPECT_EQ(SD_EVENT_ONESHOT, enabled);
+    EXPECT_EQ(microseconds(milliseconds{110}).count(), armed_time);
+    now = milliseconds{13};
+    group->add(milliseconds{100}, record(1));
+    now = milliseconds{19};
+    group->add(milliseconds{100}, record(2));
+    now = milliseconds{21};
+    group->add(milliseconds{100}, record(3));
+    EXPECT_EQ(4, group->size());
+
+    // The first three share a window, the last one starts the next
+    runUntil(milliseconds{135});
+    EXPECT_EQ((std::vector<std::pair<int, microseconds>>{
+                  {0, milliseconds{110}},
+                  {1, milliseconds{120}},
+                  {2, milliseconds{120}},
+                  {3, milliseconds{130}},
+              }),
+              fired);
+}
+
+TEST_F(TimerGroupTest, Stats)
+{
+    size_t ran = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        now = milliseconds{11 + 2 * i};
+        group->add(milliseconds{50}, [&]() { ran++; });
+    }
+    EXPECT_EQ(0, group->get_stats().wakeups);
+    EXPECT_EQ(0, group->get_stats().coalescingRatio());
+
+    runUntil(milliseconds{520});
+    EXPECT_EQ(40, ran);
+    EXPECT_EQ(10, group->get_stats().wakeups);
+    EXPECT_EQ(40, group->get_stats().dispatches);
+    EXPECT_EQ(4, group->get_stats().coalescingRatio());
+
+    group->reset_stats();
+    EXPECT_EQ(0, group->get_stats().wakeups);
+    EXPECT_EQ(0, group->get_stats().dispatches);
+}
+
+TEST_F(TimerGroupTest, NoDrift)
+{
+    std::vector<microseconds> fired;
+    group->add(milliseconds{15}, [&]() { fired.push_back(now); });
+    runUntil(milliseconds{80});
+    // Deadlines at 25, 40, 55 and 70 are each delayed to the next window
+    EXPECT_EQ((std::vector<microseconds>{milliseconds{30}, milliseconds{40},
+                                         milliseconds{60}, milliseconds{70}}),
+              fired);
+}
+
+TEST_F(TimerGroupTest, Remove)
+{
+    size_t ran = 0;
+    const auto key = group->add(milliseconds{100}, [&]() { ran++; });
+    EXPECT_TRUE(group->remove(key));
+    EXPECT_FALSE(group->remove(key));
+    EXPECT_EQ(0, group->size());
+    EXPECT_EQ(SD_EVENT_OFF, enabled);
+    runUntil(milliseconds{500});
+    EXPECT_EQ(0, ran);
+}
+
+TEST_F(TimerGroupTest, RemoveFromCallback)
+{
+    size_t ran = 0;
+    uint64_t self = 0, other = 0;
+    // Removes itself along with a timer due in the same wakeup
+    self = group->add(milliseconds{100}, [&]() {
+        ran++;
+        EXPECT_TRUE(group->remove(self));
+        EXPECT_TRUE(group->remove(other));
+    });
+    other = group->add(milliseconds{100}, [&]() { ran++; });
+    runUntil(milliseconds{500});
+    EXPECT_EQ(1, ran);
+    EXPECT_EQ(0, group->size());
+    EXPECT_EQ(SD_EVENT_OFF, enabled);
+}
+
+TEST_F(TimerGroupTest, CallbackDestroysGroup)
+{
+    size_t ran = 0;
+    auto owned = std::make_shared<int>(0);
+    for (size_t i = 0; i < 2; ++i)
+    {
+        group->add(milliseconds{100}, [&, owned]() {
+            ran++;
+            group.reset();
+        });
+    }
+    runUntil(milliseconds{500});
+    EXPECT_EQ(1, ran);
+    EXPECT_EQ(1, owned.use_count());
+}
+
+TEST_F(TimerGroupTest, CallbackThrows)
+{
+    size_t ran = 0;
+    group->add(milliseconds{100}, []() { throw std::runtime_error("timer"); });
+    group->add(milliseconds{100}, [&]() { ran++; });
+    runUntil(milliseconds{300});
+    EXPECT_EQ(2, ran);
+    EXPECT_EQ(2, group->size());
+}
+
+TEST_F(TimerGroupTest, Invalid)
+{
+    EXPECT_THROW(TestGroup(*event, microseconds{0}), std::invalid_argument);
+    EXPECT_THROW(group->add(milliseconds{0}, []() {}), std::invalid_argument);
+}
+
+} // namespace
+} // namespace utility
+} // namespace sdeventplus
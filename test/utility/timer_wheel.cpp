@@ -0,0 +1,334 @@
+#include <systemd/sd-event.h>
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/exception.hpp>
+#include <sdeventplus/test/sdevent.hpp>
+#include <sdeventplus/utility/timer_wheel.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace sdeventplus
+{
+namespace utility
+{
+namespace
+{
+
+constexpr ClockId testClock = ClockId::Monotonic;
+
+using std::chrono::hours;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+using testing::DoAll;
+using testing::Return;
+using testing::ReturnPointee;
+using testing::SaveArg;
+using testing::SetArgPointee;
+using TestWheel = TimerWheel<testClock>;
+
+class TimerWheelTest : public testing::Test
+{
+  protected:
+    testing::StrictMock<test::SdEventMock> mock;
+    sd_event* const expected_event = reinterpret_cast<sd_event*>(1234);
+    sd_event_source* const expected_source =
+        reinterpret_cast<sd_event_source*>(2345);
+    sd_event_time_handler_t handler = nullptr;
+    void* handler_userdata;
+    sd_event_destroy_t handler_destroy;
+    microseconds now{milliseconds{10}};
+    uint64_t armed_time = 0;
+    int enabled = SD_EVENT_ON;
+    size_t set_times = 0;
+    int set_time_result = 0;
+    std::unique_ptr<Event> event;
+    std::unique_ptr<TestWheel> wheel;
+
+    void SetUp()
+    {
+        EXPECT_CALL(mock, sd_event_ref(expected_event))
+            .WillRepeatedly(Return(expected_event));
+        EXPECT_CALL(mock, sd_event_unref(expected_event))
+            .WillRepeatedly(Return(nullptr));
+        event = std::make_unique<Event>(expected_event, &mock);
+        EXPECT_CALL(mock, sd_event_source_unref(expected_source))
+            .WillRepeatedly(Return(nullptr));
+        EXPECT_CALL(mock, sd_event_source_set_destroy_callback(expected_source,
+                                                               testing::_))
+            .WillRepeatedly(DoAll(SaveArg<1>(&handler_destroy), Return(0)));
+        EXPECT_CALL(mock,
+                    sd_event_source_set_userdata(expected_source, testing::_))
+            .WillRepeatedly(
+                DoAll(SaveArg<1>(&handler_userdata), Return(nullptr)));
+        EXPECT_CALL(mock, sd_event_source_get_userdata(expected_source))
+            .WillRepeatedly(ReturnPointee(&handler_userdata));
+        EXPECT_CALL(mock, sd_event_now(expected_event,
+                                       static_cast<clockid_t>(testClock),
+                                       testing::_))
+            .WillRepeatedly([&](sd_event*, clockid_t, uint64_t* usec) {
+                *usec = now.count();
+                return 0;
+            });
+        EXPECT_CALL(mock, sd_event_source_set_time(expected_source, testing::_))
+            .WillRepeatedly([&](sd_event_source*, uint64_t usec) {
+                if (set_time_result < 0)
+                {
+                    return set_time_result;
+                }
+                armed_time = usec;
+                set_times++;
+                return 0;
+            });
+        EXPECT_CALL(mock,
+                    sd_event_source_set_enabled(expected_source, testing::_))
+            .WillRepeatedly(DoAll(SaveArg<1>(&enabled), Return(0)));
+
+        EXPECT_CALL(mock,
+                    sd_event_add_time(expected_event, testing::_,
+                                      static_cast<clockid_t>(testClock), 0,
+                                      1000, testing::_, nullptr))
+            .WillOnce(DoAll(SetArgPointee<1>(expected_source),
+                            SaveArg<5>(&handler), Return(0)));
+        wheel = std::make_unique<TestWheel>(*event);
+        EXPECT_EQ(SD_EVENT_OFF, enabled);
+        EXPECT_EQ(expected_event, wheel->get_event().get());
+    }
+
+    void TearDown()
+    {
+        wheel.reset();
+        handler_destroy(handler_userdata);
+    }
+
+    /** @brief Dispatches the time source like sd-event would, until the
+     *         given time is reached
+     */
+    void runUntil(microseconds time)
+    {
+        while (enabled == SD_EVENT_ONESHOT && microseconds{armed_time} <= time)
+        {
+            now = std::max(now, microseconds{armed_time});
+            enabled = SD_EVENT_OFF;
+            EXPECT_EQ(0, handler(nullptr, armed_time, handler_userdata));
+        }
+        now = time;
+    }
+};
+
+TEST_F(TimerWheelTest, Ordering)
+{
+    std::vector<std::pair<int, microseconds>> fired;
+    auto record = [&](int id) {
+        return [&, id](TestWheel::Handle) { fired.emplace_back(id, now); };
+    };
+    wheel->add(milliseconds{30}, record(1));
+    EXPECT_EQ(SD_EVENT_ONESHOT, enabled);
+    EXPECT_EQ(microseconds(milliseconds{41}).count(), armed_time);
+    wheel->add(milliseconds{5}, record(0));
+    EXPECT_EQ(microseconds(milliseconds{16}).count(), armed_time);
+    wheel->add(milliseconds{200}, record(2));
+    wheel->add(seconds{10}, record(3));
+    EXPECT_EQ(microseconds(milliseconds{16}).count(), armed_time);
+    EXPECT_EQ(4, wheel->size());
+
+    runUntil(milliseconds{10} + seconds{20});
+    EXPECT_EQ(0, wheel->size());
+    EXPECT_EQ(SD_EVENT_OFF, enabled);
+    ASSERT_EQ(4, fired.size());
+    const microseconds expected[] = {milliseconds{16}, milliseconds{41},
+                                     milliseconds{211},
+                                     milliseconds{10011}};
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(i, fired[i].first);
+        EXPECT_EQ(expected[i], fired[i].second);
+    }
+}
+
+TEST_F(TimerWheelTest, LongTimeout)
+{
+    microseconds fired{0};
+    wheel->add(hours{24 * 365}, [&](TestWheel::Handle) { fired = now; });
+    runUntil(hours{24 * 366});
+    EXPECT_EQ(milliseconds{10} + hours{24 * 365} + milliseconds{1}, fired);
+}
+
+TEST_F(TimerWheelTest, Cancel)
+{
+    bool ran = false;
+    auto handle =
+        wheel->add(milliseconds{5}, [&](TestWheel::Handle) { ran = true; });
+    EXPECT_TRUE(wheel->pending(handle));
+    EXPECT_TRUE(wheel->cancel(handle));
+    EXPECT_FALSE(wheel->pending(handle));
+    EXPECT_FALSE(wheel->cancel(handle));
+    EXPECT_FALSE(wheel->rearm(handle, milliseconds{5}));
+    EXPECT_EQ(0, wheel->size());
+
+    // The freed entry is reused without reviving the old handle
+    auto handle2 = wheel->add(milliseconds{50}, [](TestWheel::Handle) {});
+    EXPECT_EQ(handle.index, handle2.index);
+    EXPECT_FALSE(wheel->pending(handle));
+    EXPECT_TRUE(wheel->pending(handle2));
+
+    // The spurious wakeup rearms for the remaining timer
+    runUntil(milliseconds{20});
+    EXPECT_FALSE(ran);
+    EXPECT_EQ(SD_EVENT_ONESHOT, enabled);
+    EXPECT_EQ(microseconds(milliseconds{61}).count(), armed_time);
+}
+
+TEST_F(TimerWheelTest, Rearm)
+{
+    microseconds fired{0};
+    auto handle =
+        wheel->add(milliseconds{5}, [&](TestWheel::Handle) { fired = now; });
+    EXPECT_EQ(1, set_times);
+
+    // Pushing the timer out does not touch the time source
+    EXPECT_TRUE(wheel->rearm(handle, milliseconds{100}));
+    EXPECT_EQ(1, set_times);
+    EXPECT_EQ(1, wheel->size());
+    runUntil(milliseconds{50});
+    EXPECT_EQ(microseconds{0}, fired);
+
+    EXPECT_TRUE(wheel->rearm(handle, milliseconds{10}));
+    runUntil(milliseconds{100});
+    EXPECT_EQ(milliseconds{61}, fired);
+    EXPECT_FALSE(wheel->pending(handle));
+}
+
+TEST_F(TimerWheelTest, ArmError)
+{
+    microseconds fired{0};
+    set_time_result = -ENOMEM;
+    EXPECT_THROW(wheel->add(milliseconds{5}, [](TestWheel::Handle) {}),
+                 SdEventError);
+    EXPECT_EQ(0, wheel->size());
+
+    set_time_result = 0;
+    auto handle =
+        wheel->add(milliseconds{50}, [&](TestWheel::Handle) { fired = now; });
+    set_time_result = -ENOMEM;
+    EXPECT_THROW(wheel->rearm(handle, milliseconds{5}), SdEventError);
+    EXPECT_TRUE(wheel->pending(handle));
+    EXPECT_EQ(1, wheel->size());
+
+    // The failed rearm kept the original expiration
+    set_time_result = 0;
+    runUntil(milliseconds{100});
+    EXPECT_EQ(milliseconds{61}, fired);
+    EXPECT_EQ(0, wheel->size());
+}
+
+TEST_F(TimerWheelTest, RearmFromCallback)
+{
+    std::vector<microseconds> fired;
+    wheel->add(milliseconds{10}, [&](TestWheel::Handle handle) {
+        fired.push_back(now);
+        if (fired.size() < 3)
+        {
+            EXPECT_TRUE(wheel->rearm(handle, milliseconds{10}));
+            EXPECT_TRUE(wheel->pending(handle));
+        }
+    });
+    runUntil(milliseconds{100});
+    EXPECT_EQ((std::vector<microseconds>{milliseconds{21}, milliseconds{32},
+                                         milliseconds{43}}),
+              fired);
+    EXPECT_EQ(0, wheel->size());
+}
+
+TEST_F(TimerWheelTest, CancelFromCallback)
+{
+    size_t ran = 0;
+    wheel->add(milliseconds{10}, [&](TestWheel::Handle handle) {
+        ran++;
+        EXPECT_TRUE(wheel->rearm(handle, milliseconds{10}));
+        EXPECT_TRUE(wheel->cancel(handle));
+        EXPECT_FALSE(wheel->rearm(handle, milliseconds{10}));
+    });
+    runUntil(milliseconds{100});
+    EXPECT_EQ(1, ran);
+    EXPECT_EQ(0, wheel->size());
+}
+
+TEST_F(TimerWheelTest, CallbackDestroysWheel)
+{
+    size_t ran = 0;
+    auto owned = std::make_shared<int>(0);
+    for (size_t i = 0; i < 2; ++i)
+    {
+        wheel->add(milliseconds{10}, [&, owned](TestWheel::Handle) {
+            ran++;
+            wheel.reset();
+            // The callback itself outlives the wheel until it returns
+            EXPECT_LE(2, owned.use_count());
+        });
+    }
+    runUntil(milliseconds{100});
+    EXPECT_EQ(1, ran);
+    EXPECT_EQ(1, owned.use_count());
+}
+
+TEST_F(TimerWheelTest, CallbackThrows)
+{
+    size_t ran = 0;
+    wheel->add(milliseconds{10}, [](TestWheel::Handle) {
+        throw std::runtime_error("timer");
+    });
+    wheel->add(milliseconds{10}, [&](TestWheel::Handle) { ran++; });
+    runUntil(milliseconds{100});
+    EXPECT_EQ(1, ran);
+    EXPECT_EQ(0, wheel->size());
+}
+
+TEST_F(TimerWheelTest, Random)
+{
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int64_t> timeouts(0, 10'000'000);
+    std::uniform_int_distribution<int64_t> steps(0, 20'000);
+    std::vector<microseconds> expires;
+    std::vector<TestWheel::Handle> handles;
+    size_t wrong = 0, ran = 0;
+    for (size_t i = 0; i < 2000; ++i)
+    {
+        const microseconds timeout(timeouts(rng));
+        // Timers fire on the first tick after the timeout
+        expires.push_back(
+            (now + timeout) / milliseconds{1} * milliseconds{1} +
+            milliseconds{1});
+        handles.push_back(wheel->add(timeout, [&, i](TestWheel::Handle) {
+            wrong += now != expires[i];
+            ran++;
+        }));
+        if (i % 3 == 0)
+        {
+            wheel->cancel(handles[i / 2]);
+        }
+        runUntil(now + microseconds{steps(rng)});
+    }
+    const size_t left = wheel->size();
+    runUntil(now + seconds{20});
+    EXPECT_EQ(0, wrong);
+    EXPECT_EQ(0, wheel->size());
+    EXPECT_LT(0, left);
+    EXPECT_LT(1000, ran);
+}
+
+} // namespace
+} // namespace utility
+} // namespace sdeventplus
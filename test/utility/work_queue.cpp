@@ -0,0 +1,129 @@
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/work_queue.hpp>
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace sdeventplus
+{
+namespace utility
+{
+namespace
+{
+
+class WorkQueueTest : public testing::Test
+{
+  protected:
+    Event event = Event::get_new();
+    WorkQueue queue{event, 4};
+};
+
+TEST_F(WorkQueueTest, Idle)
+{
+    EXPECT_EQ(0, queue.size());
+    EXPECT_EQ(0, event.run(std::chrono::seconds{0}));
+}
+
+TEST_F(WorkQueueTest, RunsInOrderWithinBudget)
+{
+    std::vector<int> ran;
+    for (int i = 0; i < 10; ++i)
+    {
+        queue.post([&ran, i]() { ran.push_back(i); });
+    }
+    EXPECT_EQ(10, queue.size());
+    EXPECT_TRUE(ran.empty());
+
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ((std::vector<int>{0, 1, 2, 3}), ran);
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ((std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}), ran);
+    EXPECT_EQ(0, queue.size());
+
+    // The defer source disables itself once the queue is empty
+    EXPECT_EQ(0, event.run(std::chrono::seconds{0}));
+}
+
+TEST_F(WorkQueueTest, PostFromTask)
+{
+    int ran = 0;
+    queue.set_budget(1);
+    EXPECT_EQ(1, queue.get_budget());
+    queue.post([&]() {
+        ran++;
+        queue.post([&]() { ran++; });
+    });
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ(1, ran);
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ(2, ran);
+    EXPECT_EQ(0, event.run(std::chrono::seconds{0}));
+}
+
+TEST_F(WorkQueueTest, Grows)
+{
+    size_t ran = 0;
+    queue.set_budget(1000);
+    for (size_t i = 0; i < 100; ++i)
+    {
+        queue.post([&]() { ran++; });
+    }
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ(100, ran);
+}
+
+TEST_F(WorkQueueTest, TaskThrows)
+{
+    int ran = 0;
+    queue.post([]() { throw std::runtime_error("task"); });
+    queue.post([&]() { ran++; });
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ(1, ran);
+}
+
+TEST_F(WorkQueueTest, TaskDestroysQueue)
+{
+    std::optional<WorkQueue> owned(std::in_place, event, 4);
+    auto dropped = std::make_shared<int>(0);
+    int ran = 0;
+    owned->post([&]() {
+        ran++;
+        owned.reset();
+    });
+    owned->post([&ran, dropped]() { ran++; });
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ(1, ran);
+    EXPECT_EQ(1, dropped.use_count());
+    EXPECT_EQ(0, event.run(std::chrono::seconds{0}));
+}
+
+TEST_F(WorkQueueTest, MovedFrom)
+{
+    WorkQueue moved(std::move(queue));
+    EXPECT_THROW(queue.post([]() {}), std::runtime_error);
+    EXPECT_THROW(queue.size(), std::runtime_error);
+    int ran = 0;
+    moved.post([&]() { ran++; });
+    EXPECT_EQ(1, event.run(std::chrono::seconds{0}));
+    EXPECT_EQ(1, ran);
+}
+
+TEST_F(WorkQueueTest, DropsQueued)
+{
+    auto owned = std::make_shared<int>(0);
+    queue.post([owned]() {});
+    EXPECT_EQ(2, owned.use_count());
+    queue = WorkQueue(event);
+    EXPECT_EQ(1, owned.use_count());
+}
+
+} // namespace
+} // namespace utility
+} // namespace sdeventplus